@@ -0,0 +1,92 @@
+#pragma once
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+#include "Compiler.h"
+#include "ConstantFolder.h"
+#include "Function.h"
+#include "Interpreter.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+
+
+// Each benchmark is a standalone program built together with Source/*.cxx, e.g.
+//     c++ -std=c++17 -O2 -DOYC_COUNT_INSTRUCTIONS -ISource Bench/Fib.cxx Source/*.cxx
+// OYC_COUNT_INSTRUCTIONS makes the interpreter count executed instructions so that scripts can
+// be reported in nanoseconds per instruction. OYC_COUNT_INLINE_CACHE_ACCESSES adds the inline
+// cache hit rate of field accesses.
+namespace OYC {
+
+template <class T>
+inline double MeasureNanoseconds(T &&, int = 5);
+inline void RunScript(const char *, std::string_view, int = 5);
+
+
+template <class T>
+double
+MeasureNanoseconds(T &&function, int numberOfRuns)
+{
+    double minNanoseconds = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < numberOfRuns; ++i) {
+        auto startTime = std::chrono::steady_clock::now();
+        function();
+        auto endTime = std::chrono::steady_clock::now();
+        minNanoseconds = std::min(minNanoseconds, std::chrono::duration<double, std::nano>(
+                                                  endTime - startTime).count());
+    }
+
+    return minNanoseconds;
+}
+
+
+void
+RunScript(const char *name, std::string_view source, int numberOfRuns)
+{
+    Scanner scanner;
+    scanner.setInput(source);
+    Parser parser;
+    parser.setInput(&scanner);
+    Program program = parser.readProgram();
+    ConstantFolder constantFolder;
+    constantFolder.foldProgram(&program);
+    Compiler compiler;
+    Function function = compiler.generateFunction(program);
+    std::uint64_t numberOfInstructions = 0;
+    std::uint64_t numberOfInlineCacheHits = 0;
+    std::uint64_t numberOfInlineCacheMisses = 0;
+
+    double nanoseconds = MeasureNanoseconds([&] () -> void {
+        Interpreter interpreter;
+        interpreter.execute(function, {});
+        numberOfInstructions = interpreter.getNumberOfExecutedInstructions();
+        numberOfInlineCacheHits = interpreter.getNumberOfInlineCacheHits();
+        numberOfInlineCacheMisses = interpreter.getNumberOfInlineCacheMisses();
+    }, numberOfRuns);
+
+    std::printf("%-24s %10.3f ms %12llu ops", name, nanoseconds / 1e6
+                , static_cast<unsigned long long>(numberOfInstructions));
+
+    if (numberOfInstructions == 0) {
+        std::printf("    (build with -DOYC_COUNT_INSTRUCTIONS for ns/op)\n");
+    } else {
+        std::printf(" %8.2f ns/op\n", nanoseconds / numberOfInstructions);
+    }
+
+    if (numberOfInlineCacheHits + numberOfInlineCacheMisses >= 1) {
+        std::printf("%-24s %12llu inline cache hits %12llu misses\n", ""
+                    , static_cast<unsigned long long>(numberOfInlineCacheHits)
+                    , static_cast<unsigned long long>(numberOfInlineCacheMisses));
+    }
+
+    return;
+}
+
+} // namespace OYC
@@ -0,0 +1,56 @@
+#include "Bench.h"
+
+
+int
+main()
+{
+    OYC::RunScript("field churn", R"(
+        auto sum = 0;
+
+        for (auto i = 0; i < 1000000; ++i) {
+            auto point = dict {.x = i, .y = i + 1};
+            point.z = point.x + point.y;
+            sum += point.z;
+        }
+
+        return sum;
+    )");
+
+    OYC::RunScript("integer key churn", R"(
+        auto d = dict {};
+
+        for (auto i = 0; i < 2000000; ++i) {
+            d[i] = i;
+
+            if (i >= 1000) {
+                d[i - 1000] = null;
+            }
+        }
+
+        return sizeof d;
+    )");
+
+    OYC::RunScript("string key churn", R"(
+        auto keys = {};
+
+        for (auto i = 0; i < 1000; ++i) {
+            keys[i] = "key" + (str)i;
+        }
+
+        auto d = dict {};
+
+        for (auto r = 0; r < 500; ++r) {
+            foreach (auto i, key : keys) {
+                d[key] = r;
+            }
+
+            foreach (auto i, key : keys) {
+                d[key] = null;
+            }
+        }
+
+        return sizeof d;
+    )");
+
+    return 0;
+}
@@ -0,0 +1,16 @@
+#include "Bench.h"
+
+
+int
+main()
+{
+    OYC::RunScript("fib(30)", R"(
+        auto fib = func(auto fib, auto n) {
+            return n < 2 ? n : fib(fib, n - 1) + fib(fib, n - 2);
+        };
+
+        return fib(fib, 30);
+    )");
+
+    return 0;
+}
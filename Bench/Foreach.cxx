@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+
+int
+main()
+{
+    OYC::RunScript("array build", R"(
+        auto a = {};
+
+        for (auto i = 0; i < 1000000; ++i) {
+            a[i] = i;
+        }
+
+        return sizeof a;
+    )");
+
+    OYC::RunScript("array build + 10 foreach", R"(
+        auto a = {};
+
+        for (auto i = 0; i < 1000000; ++i) {
+            a[i] = i;
+        }
+
+        auto sum = 0;
+
+        for (auto r = 0; r < 10; ++r) {
+            foreach (auto v : a) {
+                sum += v;
+            }
+        }
+
+        return sum;
+    )");
+
+    OYC::RunScript("dictionary build", R"(
+        auto d = dict {};
+
+        for (auto i = 0; i < 1000000; ++i) {
+            d[i] = i;
+        }
+
+        return sizeof d;
+    )");
+
+    OYC::RunScript("dictionary build + 10 foreach", R"(
+        auto d = dict {};
+
+        for (auto i = 0; i < 1000000; ++i) {
+            d[i] = i;
+        }
+
+        auto sum = 0;
+
+        for (auto r = 0; r < 10; ++r) {
+            foreach (auto k, v : d) {
+                sum += v;
+            }
+        }
+
+        return sum;
+    )");
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "Scanner.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+const int NumberOfNames = 500000;
+
+const char *const Identifiers[] = {
+    "i", "n", "x", "value", "index", "count", "format", "iffy", "returned", "default_value",
+    "dictionary", "function", "automatic", "breakpoint", "continuation", "whileLoop", "done",
+    "forward", "foreachable", "size", "boolean", "integer", "floating", "string", "thisValue",
+    "_private", "Node", "MAX_LENGTH", "a1", "tmp"
+};
+
+
+std::string MakeInput();
+Token ReadName(Scanner *);
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    std::string input = OYC::MakeInput();
+    std::vector<std::string_view> names;
+    OYC::Scanner scanner;
+    scanner.setInput(input);
+
+    for (;;) {
+        OYC::Token token = OYC::ReadName(&scanner);
+
+        if (token.type == OYC::TokenType::EndOfFile) {
+            break;
+        }
+
+        names.push_back(token.value);
+    }
+
+    std::unordered_map<std::string, OYC::TokenType> keywordToTokenType;
+
+    for (auto k = static_cast<std::underlying_type_t<OYC::TokenType>>(
+                  OYC::TokenType::KeywordBegin)
+         ; k < static_cast<std::underlying_type_t<OYC::TokenType>>(OYC::TokenType::KeywordEnd)
+         ; ++k) {
+        auto tokenType = static_cast<OYC::TokenType>(k);
+        keywordToTokenType.emplace(OYC::TokenTypeToString(tokenType), tokenType);
+    }
+
+    std::uint64_t checksum = 0;
+
+    double mapTime = OYC::MeasureNanoseconds([&] () -> void {
+        for (std::string_view name : names) {
+            auto it = keywordToTokenType.find(std::string(name));
+            OYC::TokenType tokenType = it == keywordToTokenType.end()
+                                       ? OYC::TokenType::Identifier : it->second;
+            checksum += static_cast<std::uint64_t>(tokenType);
+        }
+    });
+
+    double tableTime = OYC::MeasureNanoseconds([&] () -> void {
+        for (std::string_view name : names) {
+            checksum += static_cast<std::uint64_t>(OYC::NameToTokenType(name));
+        }
+    });
+
+    double scanTime = OYC::MeasureNanoseconds([&] () -> void {
+        OYC::Scanner scanner;
+        scanner.setInput(input);
+
+        while (OYC::ReadName(&scanner).type != OYC::TokenType::EndOfFile) {
+            ++checksum;
+        }
+    });
+
+    std::printf("unordered_map lookup %8.2f ns/name\n", mapTime / names.size());
+    std::printf("dispatch table       %8.2f ns/name\n", tableTime / names.size());
+    std::printf("scanner              %8.2f ns/token (%llu)\n", scanTime / names.size()
+                , static_cast<unsigned long long>(checksum));
+    return 0;
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::string
+MakeInput()
+{
+    const int numberOfIdentifiers = sizeof(Identifiers) / sizeof(Identifiers[0]);
+    const int numberOfKeywords = static_cast<int>(TokenType::KeywordEnd)
+                                 - static_cast<int>(TokenType::KeywordBegin);
+    std::string input;
+    std::uint32_t state = 1;
+
+    for (int i = 0; i < NumberOfNames; ++i) {
+        state = state * 1103515245 + 12345;
+        int k = state >> 16;
+
+        // Four names in five are identifiers.
+        if (k % 5 == 0) {
+            auto tokenType = static_cast<TokenType>(static_cast<int>(TokenType::KeywordBegin)
+                                                    + k / 5 % numberOfKeywords);
+            input += TokenTypeToString(tokenType);
+        } else {
+            input += Identifiers[k / 5 % numberOfIdentifiers];
+        }
+
+        input += i % 16 == 15 ? '\n' : ' ';
+    }
+
+    return input;
+}
+
+
+Token
+ReadName(Scanner *scanner)
+{
+    Token token;
+
+    do {
+        token = scanner->readToken();
+    } while (token.type == TokenType::WhiteSpace);
+
+    return token;
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,46 @@
+#include "Bench.h"
+
+
+int
+main()
+{
+    OYC::RunScript("for loop", R"(
+        auto sum = 0;
+
+        for (auto i = 0; i < 10000000; ++i) {
+            sum += i & 7;
+        }
+
+        return sum;
+    )");
+
+    OYC::RunScript("nested while loops", R"(
+        auto sum = 0;
+        auto i = 0;
+
+        while (i < 3000) {
+            auto j = 0;
+
+            while (j < 3000) {
+                sum += i * j % 13;
+                ++j;
+            }
+
+            ++i;
+        }
+
+        return sum;
+    )");
+
+    OYC::RunScript("floating-point loop", R"(
+        auto x = 0.0;
+
+        for (auto i = 0; i < 5000000; ++i) {
+            x = x * 0.5 + i;
+        }
+
+        return x;
+    )");
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Bench.h"
+#include "Compiler.h"
+#include "Function.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+
+
+namespace OYC {
+
+namespace {
+
+std::string MakeInput(int);
+void CompileManyLocals(int);
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    for (int numberOfLocals : {100, 1000, 10000, 50000}) {
+        OYC::CompileManyLocals(numberOfLocals);
+    }
+
+    return 0;
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::string
+MakeInput(int numberOfLocals)
+{
+    std::string input = "auto v0 = 0;\n";
+    std::uint32_t state = 1;
+
+    for (int i = 1; i < numberOfLocals; ++i) {
+        state = state * 1103515245 + 12345;
+        std::string j = std::to_string((state >> 16) % i);
+        input += "auto v" + std::to_string(i) + " = v" + j + " + " + std::to_string(i) + ";\n";
+    }
+
+    input += "return v" + std::to_string(numberOfLocals - 1) + ";\n";
+    return input;
+}
+
+
+void
+CompileManyLocals(int numberOfLocals)
+{
+    std::string input = MakeInput(numberOfLocals);
+    Scanner scanner;
+    scanner.setInput(input);
+    Parser parser;
+    parser.setInput(&scanner);
+    Program program = parser.readProgram();
+    std::size_t numberOfInstructions = 0;
+
+    double nanoseconds = MeasureNanoseconds([&] () -> void {
+        Compiler compiler;
+        numberOfInstructions = compiler.generateFunction(program).code.size();
+    });
+
+    std::printf("%6d locals: %9.3f ms, %7.1f ns/local (%zu instructions)\n", numberOfLocals
+                , nanoseconds / 1e6, nanoseconds / numberOfLocals, numberOfInstructions);
+    return;
+}
+
+} // namespace
+
+} // namespace OYC
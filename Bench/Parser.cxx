@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "Bench.h"
+#include "Expression.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "Statement.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+const int NumberOfFunctions = 20000;
+
+std::uint64_t NumberOfAllocations = 0;
+
+
+std::string MakeInput();
+
+} // namespace
+
+} // namespace OYC
+
+
+void *
+operator new(std::size_t size)
+{
+    ++OYC::NumberOfAllocations;
+    void *memory = std::malloc(size == 0 ? 1 : size);
+
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+
+void
+operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+
+void
+operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+
+int
+main()
+{
+    std::string input = OYC::MakeInput();
+    std::uint64_t numberOfTokens = 0;
+    OYC::Scanner scanner;
+    scanner.setInput(input);
+
+    while (scanner.readSignificantToken().type != OYC::TokenType::EndOfFile) {
+        ++numberOfTokens;
+    }
+
+    std::uint64_t numberOfAllocations = 0;
+
+    double nanoseconds = OYC::MeasureNanoseconds([&] () -> void {
+        OYC::Scanner scanner;
+        scanner.setInput(input);
+        OYC::Parser parser;
+        parser.setInput(&scanner);
+        std::uint64_t numberOfAllocations1 = OYC::NumberOfAllocations;
+        OYC::Program program = parser.readProgram();
+        numberOfAllocations = OYC::NumberOfAllocations - numberOfAllocations1;
+    });
+
+    std::printf("%llu tokens: %.2f M tokens/s, %.2f ns/token, %.3f allocations/token\n"
+                , static_cast<unsigned long long>(numberOfTokens)
+                , numberOfTokens / nanoseconds * 1e3, nanoseconds / numberOfTokens
+                , static_cast<double>(numberOfAllocations) / numberOfTokens);
+    return 0;
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::string
+MakeInput()
+{
+    std::string input;
+
+    for (int i = 0; i < NumberOfFunctions; ++i) {
+        std::string name = "function" + std::to_string(i);
+        input += "auto " + name + " = func(auto a, auto b, ...) {\n"
+                 "    auto sum = 0;\n"
+                 "\n"
+                 "    for (auto i = 0; i < a; ++i) {\n"
+                 "        if (i % 3 == 0) {\n"
+                 "            sum += b * i;\n"
+                 "        } else {\n"
+                 "            sum -= (int)(i / 2.5);\n"
+                 "        }\n"
+                 "    }\n"
+                 "\n"
+                 "    auto d = dict {.x = a, .y = b, [\"sum\"] = sum};\n"
+                 "    return {sum, d.x, d[\"y\"], \"" + name + "\", ...};\n"
+                 "};\n";
+    }
+
+    return input;
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,44 @@
+#include "Bench.h"
+
+
+int
+main()
+{
+    OYC::RunScript("append characters", R"(
+        auto s = "";
+
+        for (auto i = 0; i < 1000000; ++i) {
+            s += "x";
+        }
+
+        return sizeof s;
+    )");
+
+    OYC::RunScript("append numbers", R"(
+        auto s = "";
+
+        for (auto i = 0; i < 300000; ++i) {
+            s += (str)i + ",";
+        }
+
+        return sizeof s;
+    )");
+
+    OYC::RunScript("build and index", R"(
+        auto n = 0;
+
+        for (auto r = 0; r < 1000; ++r) {
+            auto s = "";
+
+            for (auto i = 0; i < 100; ++i) {
+                s += "ab";
+            }
+
+            n += sizeof s + (s[r % 200] == "a" ? 1 : 0);
+        }
+
+        return n;
+    )");
+
+    return 0;
+}
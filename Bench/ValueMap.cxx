@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "Heap.h"
+#include "Object.h"
+#include "ValueMap.h"
+
+
+namespace OYC {
+
+namespace {
+
+const int NumberOfKeys = 200000;
+
+
+struct ValueHasher
+{
+    std::size_t operator()(Value value) const
+    {
+        return HashValue(value);
+    }
+};
+
+
+struct ValueEqualityComparer
+{
+    bool operator()(Value value1, Value value2) const
+    {
+        return ValuesAreEqual(value1, value2);
+    }
+};
+
+
+typedef std::unordered_map<Value, Value, ValueHasher, ValueEqualityComparer> UnorderedMap;
+
+
+void Set(ValueMap *, Value, Value);
+void Set(UnorderedMap *, Value, Value);
+Value Get(const ValueMap &, Value);
+Value Get(const UnorderedMap &, Value);
+void Erase(ValueMap *, Value);
+void Erase(UnorderedMap *, Value);
+std::int64_t Sum(const ValueMap &);
+std::int64_t Sum(const UnorderedMap &);
+template <class T>
+void RunMixes(const char *, const char *, const std::vector<Value> &);
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::Heap heap;
+    std::vector<OYC::Value> integerKeys;
+    std::vector<OYC::Value> stringKeys;
+
+    for (int i = 0; i < OYC::NumberOfKeys; ++i) {
+        integerKeys.push_back(OYC::Value::MakeSmallInteger(i));
+        auto string = heap.createObject<OYC::String>();
+        string->value = "key" + std::to_string(i);
+        stringKeys.push_back(OYC::Value::MakeObject(OYC::ValueType::String, string));
+    }
+
+    OYC::RunMixes<OYC::ValueMap>("ValueMap", "integer", integerKeys);
+    OYC::RunMixes<OYC::UnorderedMap>("unordered_map", "integer", integerKeys);
+    OYC::RunMixes<OYC::ValueMap>("ValueMap", "string", stringKeys);
+    OYC::RunMixes<OYC::UnorderedMap>("unordered_map", "string", stringKeys);
+    return 0;
+}
+
+
+namespace OYC {
+
+namespace {
+
+void
+Set(ValueMap *map, Value key, Value value)
+{
+    map->set(key, value);
+    return;
+}
+
+
+void
+Set(UnorderedMap *map, Value key, Value value)
+{
+    (*map)[key] = value;
+    return;
+}
+
+
+Value
+Get(const ValueMap &map, Value key)
+{
+    return map.get(key);
+}
+
+
+Value
+Get(const UnorderedMap &map, Value key)
+{
+    auto it = map.find(key);
+    return it == map.end() ? Value() : it->second;
+}
+
+
+void
+Erase(ValueMap *map, Value key)
+{
+    map->erase(key);
+    return;
+}
+
+
+void
+Erase(UnorderedMap *map, Value key)
+{
+    map->erase(key);
+    return;
+}
+
+
+std::int64_t
+Sum(const ValueMap &map)
+{
+    std::int64_t sum = 0;
+
+    for (std::size_t i = 0; i < map.getNumberOfEntries(); ++i) {
+        const ValueMap::Entry &entry = map.getEntry(i);
+
+        if (!entry.value.isNull()) {
+            sum += entry.value.getSmallInteger();
+        }
+    }
+
+    return sum;
+}
+
+
+std::int64_t
+Sum(const UnorderedMap &map)
+{
+    std::int64_t sum = 0;
+
+    for (const std::pair<const Value, Value> &entry : map) {
+        sum += entry.second.getSmallInteger();
+    }
+
+    return sum;
+}
+
+
+template <class T>
+void
+RunMixes(const char *name, const char *keyType, const std::vector<Value> &keys)
+{
+    std::size_t numberOfKeys = keys.size();
+    std::int64_t checksum = 0;
+
+    double insertTime = MeasureNanoseconds([&] () -> void {
+        T map;
+
+        for (std::size_t i = 0; i < numberOfKeys; ++i) {
+            Set(&map, keys[i], Value::MakeSmallInteger(i));
+        }
+    });
+
+    T map;
+
+    for (std::size_t i = 0; i < numberOfKeys; ++i) {
+        Set(&map, keys[i], Value::MakeSmallInteger(i));
+    }
+
+    double lookupTime = MeasureNanoseconds([&] () -> void {
+        for (std::size_t i = 0; i < numberOfKeys; ++i) {
+            checksum += Get(map, keys[i * 7919 % numberOfKeys]).getSmallInteger();
+        }
+    });
+
+    double churnTime = MeasureNanoseconds([&] () -> void {
+        for (std::size_t i = 0; i < numberOfKeys; i += 2) {
+            Erase(&map, keys[i]);
+        }
+
+        for (std::size_t i = 0; i < numberOfKeys; i += 2) {
+            Set(&map, keys[i], Value::MakeSmallInteger(i));
+        }
+    });
+
+    double iterateTime = MeasureNanoseconds([&] () -> void {
+        checksum += Sum(map);
+    });
+
+    std::printf("%-14s %-8s insert %6.2f  lookup %6.2f  erase+insert %6.2f  iterate %6.2f"
+                "  ns/key (%lld)\n", name, keyType, insertTime / numberOfKeys
+                , lookupTime / numberOfKeys, churnTime / numberOfKeys
+                , iterateTime / numberOfKeys, static_cast<long long>(checksum));
+    return;
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,27 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+
+namespace OYC {
+
+namespace {
+
+const std::size_t MinChunkSize = 4096;
+const std::size_t MaxChunkSize = 1024 * 1024;
+
+} // namespace
+
+
+void *
+Arena::allocateSlowly(std::size_t size, std::size_t alignment)
+{
+    chunkSize_ = chunkSize_ == 0 ? MinChunkSize : std::min(2 * chunkSize_, MaxChunkSize);
+    std::size_t chunkSize = std::max(chunkSize_, size + alignment - 1);
+    chunks_.emplace_back(new char[chunkSize]);
+    chunkPosition_ = chunks_.back().get();
+    chunkEnd_ = chunkPosition_ + chunkSize;
+    return allocate(size, alignment);
+}
+
+} // namespace OYC
@@ -0,0 +1,176 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace OYC {
+
+template <class T>
+class ArenaArray final
+{
+    static_assert(std::is_trivially_destructible<T>::value, "");
+
+public:
+    inline ArenaArray() noexcept;
+    inline explicit ArenaArray(T *, std::size_t) noexcept;
+
+    inline bool isEmpty() const noexcept;
+    inline std::size_t getSize() const noexcept;
+    inline T *begin() const noexcept;
+    inline T *end() const noexcept;
+    inline T &operator[](std::size_t) const noexcept;
+
+private:
+    T *elements_;
+    std::size_t size_;
+};
+
+
+class Arena final
+{
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+public:
+    inline explicit Arena() noexcept;
+    inline Arena(Arena &&) noexcept;
+
+    inline void *allocate(std::size_t, std::size_t);
+
+    template <class T, class ...U>
+    inline T *create(U &&...);
+
+    template <class T>
+    inline ArenaArray<T> makeArray(const T *, std::size_t);
+
+private:
+    std::vector<std::unique_ptr<char []>> chunks_;
+    std::size_t chunkSize_;
+    char *chunkPosition_;
+    char *chunkEnd_;
+
+    void *allocateSlowly(std::size_t, std::size_t);
+};
+
+
+template <class T>
+ArenaArray<T>::ArenaArray() noexcept
+  : elements_(nullptr),
+    size_(0)
+{
+}
+
+
+template <class T>
+ArenaArray<T>::ArenaArray(T *elements, std::size_t size) noexcept
+  : elements_(elements),
+    size_(size)
+{
+}
+
+
+template <class T>
+bool
+ArenaArray<T>::isEmpty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <class T>
+std::size_t
+ArenaArray<T>::getSize() const noexcept
+{
+    return size_;
+}
+
+
+template <class T>
+T *
+ArenaArray<T>::begin() const noexcept
+{
+    return elements_;
+}
+
+
+template <class T>
+T *
+ArenaArray<T>::end() const noexcept
+{
+    return elements_ + size_;
+}
+
+
+template <class T>
+T &
+ArenaArray<T>::operator[](std::size_t index) const noexcept
+{
+    return elements_[index];
+}
+
+
+Arena::Arena() noexcept
+  : chunkSize_(0),
+    chunkPosition_(nullptr),
+    chunkEnd_(nullptr)
+{
+}
+
+
+Arena::Arena(Arena &&other) noexcept
+  : chunks_(std::move(other.chunks_)),
+    chunkSize_(other.chunkSize_),
+    chunkPosition_(other.chunkPosition_),
+    chunkEnd_(other.chunkEnd_)
+{
+    other.chunks_.clear();
+    other.chunkSize_ = 0;
+    other.chunkPosition_ = nullptr;
+    other.chunkEnd_ = nullptr;
+}
+
+
+void *
+Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    auto position = reinterpret_cast<std::uintptr_t>(chunkPosition_);
+    position = (position + alignment - 1) & ~(alignment - 1);
+
+    if (position + size > reinterpret_cast<std::uintptr_t>(chunkEnd_)) {
+        return allocateSlowly(size, alignment);
+    }
+
+    chunkPosition_ = reinterpret_cast<char *>(position + size);
+    return reinterpret_cast<void *>(position);
+}
+
+
+template <class T, class ...U>
+T *
+Arena::create(U &&...argument)
+{
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<U>(argument)...);
+}
+
+
+template <class T>
+ArenaArray<T>
+Arena::makeArray(const T *elements, std::size_t numberOfElements)
+{
+    if (numberOfElements == 0) {
+        return ArenaArray<T>();
+    }
+
+    auto result = static_cast<T *>(allocate(numberOfElements * sizeof(T), alignof(T)));
+    std::uninitialized_copy(elements, elements + numberOfElements, result);
+    return ArenaArray<T>(result, numberOfElements);
+}
+
+} // namespace OYC
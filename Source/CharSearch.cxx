@@ -0,0 +1,314 @@
+#include "CharSearch.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#   define OYC_CHAR_SEARCH_X86
+#   include <immintrin.h>
+#endif
+
+
+namespace OYC {
+
+namespace {
+
+struct CharSearchKernels
+{
+    const char *(*skipWhiteSpaces)(const char *, const char *);
+    const char *(*skipNameChars)(const char *, const char *);
+    const char *(*findStringLiteralDelimiter)(const char *, const char *);
+};
+
+
+bool IsWhiteSpace(unsigned char);
+bool IsNameChar(unsigned char);
+bool IsStringLiteralDelimiter(unsigned char);
+
+const char *ScalarSkipWhiteSpaces(const char *, const char *);
+const char *ScalarSkipNameChars(const char *, const char *);
+const char *ScalarFindStringLiteralDelimiter(const char *, const char *);
+
+#ifdef OYC_CHAR_SEARCH_X86
+__m128i SSE2MatchWhiteSpaces(__m128i);
+__m128i SSE2MatchNameChars(__m128i);
+__m128i SSE2MatchStringLiteralDelimiters(__m128i);
+const char *SSE2SkipWhiteSpaces(const char *, const char *);
+const char *SSE2SkipNameChars(const char *, const char *);
+const char *SSE2FindStringLiteralDelimiter(const char *, const char *);
+
+__m256i AVX2MatchWhiteSpaces(__m256i);
+__m256i AVX2MatchNameChars(__m256i);
+__m256i AVX2MatchStringLiteralDelimiters(__m256i);
+const char *AVX2SkipWhiteSpaces(const char *, const char *);
+const char *AVX2SkipNameChars(const char *, const char *);
+const char *AVX2FindStringLiteralDelimiter(const char *, const char *);
+#endif
+
+const CharSearchKernels Kernels = [] () -> CharSearchKernels {
+#ifdef OYC_CHAR_SEARCH_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return {AVX2SkipWhiteSpaces, AVX2SkipNameChars, AVX2FindStringLiteralDelimiter};
+    } else {
+        return {SSE2SkipWhiteSpaces, SSE2SkipNameChars, SSE2FindStringLiteralDelimiter};
+    }
+#else
+    return {ScalarSkipWhiteSpaces, ScalarSkipNameChars, ScalarFindStringLiteralDelimiter};
+#endif
+}();
+
+} // namespace
+
+
+const char *
+SkipWhiteSpaces(const char *first, const char *last)
+{
+    return Kernels.skipWhiteSpaces(first, last);
+}
+
+
+const char *
+SkipNameChars(const char *first, const char *last)
+{
+    return Kernels.skipNameChars(first, last);
+}
+
+
+const char *
+FindStringLiteralDelimiter(const char *first, const char *last)
+{
+    return Kernels.findStringLiteralDelimiter(first, last);
+}
+
+
+const char *
+FindChar(const char *first, const char *last, char c)
+{
+    if (first == last) {
+        return last;
+    }
+
+    auto result = static_cast<const char *>(std::memchr(first, c, last - first));
+    return result == nullptr ? last : result;
+}
+
+
+namespace {
+
+bool
+IsWhiteSpace(unsigned char c)
+{
+    return c == ' ' || c - unsigned('\t') <= unsigned('\r' - '\t');
+}
+
+
+bool
+IsNameChar(unsigned char c)
+{
+    return c - unsigned('0') <= 9u || (c | 0x20u) - unsigned('a') <= 25u || c == '_';
+}
+
+
+bool
+IsStringLiteralDelimiter(unsigned char c)
+{
+    return c == '\"' || c == '\\' || c == '\n';
+}
+
+
+const char *
+ScalarSkipWhiteSpaces(const char *first, const char *last)
+{
+    while (first < last && IsWhiteSpace(*first)) {
+        ++first;
+    }
+
+    return first;
+}
+
+
+const char *
+ScalarSkipNameChars(const char *first, const char *last)
+{
+    while (first < last && IsNameChar(*first)) {
+        ++first;
+    }
+
+    return first;
+}
+
+
+const char *
+ScalarFindStringLiteralDelimiter(const char *first, const char *last)
+{
+    while (first < last && !IsStringLiteralDelimiter(*first)) {
+        ++first;
+    }
+
+    return first;
+}
+
+
+#ifdef OYC_CHAR_SEARCH_X86
+__m128i
+SSE2MatchWhiteSpaces(__m128i x)
+{
+    __m128i y = _mm_subs_epu8(_mm_sub_epi8(x, _mm_set1_epi8('\t')), _mm_set1_epi8('\r' - '\t'));
+    return _mm_or_si128(_mm_cmpeq_epi8(y, _mm_setzero_si128())
+                        , _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+}
+
+
+__m128i
+SSE2MatchNameChars(__m128i x)
+{
+    __m128i y = _mm_subs_epu8(_mm_sub_epi8(x, _mm_set1_epi8('0')), _mm_set1_epi8(9));
+    __m128i z = _mm_subs_epu8(_mm_sub_epi8(_mm_or_si128(x, _mm_set1_epi8(0x20))
+                                           , _mm_set1_epi8('a')), _mm_set1_epi8(25));
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(y, _mm_setzero_si128())
+                                     , _mm_cmpeq_epi8(z, _mm_setzero_si128()))
+                        , _mm_cmpeq_epi8(x, _mm_set1_epi8('_')));
+}
+
+
+__m128i
+SSE2MatchStringLiteralDelimiters(__m128i x)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\"'))
+                                     , _mm_cmpeq_epi8(x, _mm_set1_epi8('\\')))
+                        , _mm_cmpeq_epi8(x, _mm_set1_epi8('\n')));
+}
+
+
+const char *
+SSE2SkipWhiteSpaces(const char *first, const char *last)
+{
+    for (; last - first >= 16; first += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        unsigned int m = ~_mm_movemask_epi8(SSE2MatchWhiteSpaces(x)) & 0xFFFF;
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return ScalarSkipWhiteSpaces(first, last);
+}
+
+
+const char *
+SSE2SkipNameChars(const char *first, const char *last)
+{
+    for (; last - first >= 16; first += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        unsigned int m = ~_mm_movemask_epi8(SSE2MatchNameChars(x)) & 0xFFFF;
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return ScalarSkipNameChars(first, last);
+}
+
+
+const char *
+SSE2FindStringLiteralDelimiter(const char *first, const char *last)
+{
+    for (; last - first >= 16; first += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        unsigned int m = _mm_movemask_epi8(SSE2MatchStringLiteralDelimiters(x));
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return ScalarFindStringLiteralDelimiter(first, last);
+}
+
+
+__attribute__((target("avx2"))) __m256i
+AVX2MatchWhiteSpaces(__m256i x)
+{
+    __m256i y = _mm256_subs_epu8(_mm256_sub_epi8(x, _mm256_set1_epi8('\t'))
+                                 , _mm256_set1_epi8('\r' - '\t'));
+    return _mm256_or_si256(_mm256_cmpeq_epi8(y, _mm256_setzero_si256())
+                           , _mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')));
+}
+
+
+__attribute__((target("avx2"))) __m256i
+AVX2MatchNameChars(__m256i x)
+{
+    __m256i y = _mm256_subs_epu8(_mm256_sub_epi8(x, _mm256_set1_epi8('0')), _mm256_set1_epi8(9));
+    __m256i z = _mm256_subs_epu8(_mm256_sub_epi8(_mm256_or_si256(x, _mm256_set1_epi8(0x20))
+                                                 , _mm256_set1_epi8('a'))
+                                 , _mm256_set1_epi8(25));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(y, _mm256_setzero_si256())
+                                           , _mm256_cmpeq_epi8(z, _mm256_setzero_si256()))
+                           , _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_')));
+}
+
+
+__attribute__((target("avx2"))) __m256i
+AVX2MatchStringLiteralDelimiters(__m256i x)
+{
+    return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\"'))
+                                           , _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\')))
+                           , _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')));
+}
+
+
+__attribute__((target("avx2"))) const char *
+AVX2SkipWhiteSpaces(const char *first, const char *last)
+{
+    for (; last - first >= 32; first += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        unsigned int m = ~static_cast<unsigned int>(_mm256_movemask_epi8(AVX2MatchWhiteSpaces(x)));
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return SSE2SkipWhiteSpaces(first, last);
+}
+
+
+__attribute__((target("avx2"))) const char *
+AVX2SkipNameChars(const char *first, const char *last)
+{
+    for (; last - first >= 32; first += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        unsigned int m = ~static_cast<unsigned int>(_mm256_movemask_epi8(AVX2MatchNameChars(x)));
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return SSE2SkipNameChars(first, last);
+}
+
+
+__attribute__((target("avx2"))) const char *
+AVX2FindStringLiteralDelimiter(const char *first, const char *last)
+{
+    for (; last - first >= 32; first += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        auto m = static_cast<unsigned int>(_mm256_movemask_epi8(AVX2MatchStringLiteralDelimiters(x)));
+
+        if (m != 0) {
+            return first + __builtin_ctz(m);
+        }
+    }
+
+    return SSE2FindStringLiteralDelimiter(first, last);
+}
+#endif
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,11 @@
+#pragma once
+
+
+namespace OYC {
+
+const char *SkipWhiteSpaces(const char *, const char *);
+const char *SkipNameChars(const char *, const char *);
+const char *FindStringLiteralDelimiter(const char *, const char *);
+const char *FindChar(const char *, const char *, char);
+
+} // namespace OYC
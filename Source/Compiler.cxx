@@ -1,49 +1,1282 @@
 #include "Compiler.h"
 
-#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "Error.h"
+#include "Expression.h"
+#include "Function.h"
+#include "Program.h"
+#include "ScopeGuard.h"
+#include "Statement.h"
+#include "StringInterner.h"
+
 
 namespace OYC {
 
-class CompilationContext final
+class CompilationContext final
+{
+    CompilationContext(const CompilationContext &) = delete;
+    CompilationContext &operator=(const CompilationContext &) = delete;
+
+public:
+    explicit CompilationContext(CompilationContext *, Function *);
+
+    Function *getFunction() const;
+    int getSuperRegisterID(SymbolID) const;
+    bool isSuperCellRegister(SymbolID) const;
+    int getNumberOfRegisters() const;
+    void addRegister(SymbolID, bool = false);
+    bool isCellRegister(int) const;
+    void deleteRegisters(int);
+    void pushRegisterID(SymbolID);
+    int pushRegisterID();
+    int popRegisterID();
+    int peekRegisterID(int) const;
+
+    void setLineNumber(int);
+    int emitInstruction(Instruction);
+    void deleteLastInstruction();
+    Instruction *getLastInstruction();
+    int addLabel();
+    bool isLabeled() const;
+    void setJumpTarget(int, int);
+
+    int getIntegerConstantIndex(std::int64_t);
+    int getFloatingPointConstantIndex(double);
+    int getStringConstantIndex(SymbolID, std::string_view);
+    int getNumberOfFieldSites() const;
+    int addFieldSite(int);
+
+    void beginLoop();
+    void endLoop(int, int);
+    void beginSwitch();
+    void endSwitch(int);
+    bool addBreakJump(int);
+    bool addContinueJump(int);
+
+private:
+    CompilationContext *const super_;
+    Function *const function_;
+    std::vector<SymbolID> registerIDToName_;
+    std::vector<int> registerIDToShadowedRegisterID_;
+    std::vector<bool> registerIDToCellFlag_;
+    std::unordered_map<SymbolID, int> nameToRegisterID_;
+    std::vector<int> registerIDs_;
+    int lineNumber_;
+    int lastLabel_;
+    std::unordered_map<std::int64_t, int> integerToConstantIndex_;
+    std::unordered_map<std::uint64_t, int> floatingPointToConstantIndex_;
+    std::unordered_map<SymbolID, int> stringToConstantIndex_;
+    std::vector<std::vector<int>> breakJumpLists_;
+    std::vector<std::vector<int>> continueJumpLists_;
+
+    int getRegisterID(SymbolID) const;
+};
+
+
+namespace {
+
+const int MaxNumberOfRegisters = std::numeric_limits<std::uint16_t>::max() + 1;
+const int MaxShortOperand = std::numeric_limits<std::uint16_t>::max();
+const std::int64_t MaxExactInteger = INT64_C(1) << 53;
+
+
+const PrimaryExpression *AsPrimaryExpression(const Expression *, PrimaryExpressionType);
+bool MayWriteVariables(const Expression *);
+OpCode UnaryOperatorToOpCode(TokenType);
+OpCode BinaryOperatorToOpCode(TokenType);
+bool OpCodeSetsA(OpCode);
+int GetSizeHint(std::size_t);
+void ResolveSwitchTable(SwitchTable *, const std::vector<int> &, int);
+
+} // namespace
+
+
+Function
+Compiler::generateFunction(const Program &program)
+{
+    Function function;
+    program_ = &program;
+    context_ = nullptr;
+    generateFunction(program.main, &function);
+    return function;
+}
+
+
+void
+Compiler::generateFunction(const FunctionLiteral &functionLiteral, Function *function)
+{
+    ScopeGuard scopeGuard([this, f = functionLiteral_, c = context_, s = statement_] () -> void {
+        functionLiteral_ = f;
+        context_ = c;
+        statement_ = s;
+    });
+
+    CompilationContext context(context_, function);
+
+    for (SymbolID superVariableName : functionLiteral.superVariableNames) {
+        function->upvalueDescriptors.push_back({context.getSuperRegisterID(superVariableName)});
+    }
+
+    functionLiteral_ = &functionLiteral;
+    context_ = &context;
+    scopeGuard.commit();
+    function->numberOfParameters = static_cast<int>(functionLiteral.parameters.size());
+    function->isVariadic = functionLiteral.isVariadic;
+
+    for (SymbolID parameter : functionLiteral.parameters) {
+        addVariable(parameter);
+    }
+
+    for (SymbolID superVariableName : functionLiteral.superVariableNames) {
+        context_->addRegister(superVariableName, context_->isSuperCellRegister(superVariableName));
+    }
+
+    for (int i = 0; i < function->numberOfParameters; ++i) {
+        if (context_->isCellRegister(i)) {
+            context_->emitInstruction(MakeInstruction(OpCode::NewCell, i, i));
+        }
+    }
+
+    generateStatements(functionLiteral.body);
+    context_->emitInstruction(MakeInstruction(OpCode::ReturnNull));
+    return;
+}
+
+
+void
+Compiler::addVariable(SymbolID variableName)
+{
+    const std::vector<SymbolID> &cellVariableNames = functionLiteral_->cellVariableNames;
+    bool isCell = std::find(cellVariableNames.begin(), cellVariableNames.end(), variableName)
+                  != cellVariableNames.end();
+    context_->addRegister(variableName, isCell);
+    return;
+}
+
+
+void
+Compiler::generateStatements(const ArenaArray<Statement *> &statements)
+{
+    for (const Statement *statement : statements) {
+        statement->acceptVisit(this);
+    }
+
+    return;
+}
+
+
+void
+Compiler::generateExpression(const Expression *expression)
+{
+    expression->acceptVisit(this);
+    return;
+}
+
+
+void
+Compiler::generateDiscardedExpression(const Expression *expression)
+{
+    auto unaryExpression = dynamic_cast<const UnaryExpression *>(expression);
+
+    if (unaryExpression != nullptr && unaryExpression->type == UnaryExpressionType::Postfix) {
+        generateIncrement(*unaryExpression, true);
+    } else {
+        generateExpression(expression);
+    }
+
+    int registerID = context_->popRegisterID();
+
+    if (registerID >= context_->getNumberOfRegisters() && !context_->isLabeled()) {
+        const Instruction *instruction = context_->getLastInstruction();
+
+        if (instruction != nullptr && instruction->opCode == OpCode::Move
+            && instruction->a == registerID) {
+            context_->deleteLastInstruction();
+        }
+    }
+
+    return;
+}
+
+
+void
+Compiler::generateArrayLiteral(const ArrayLiteral &arrayLiteral)
+{
+    int arrayRegisterID = context_->pushRegisterID();
+    int sizeHint = GetSizeHint(arrayLiteral.elements.getSize());
+    context_->emitInstruction(MakeInstruction(OpCode::NewArray, arrayRegisterID, sizeHint));
+
+    for (const Expression *element : arrayLiteral.elements) {
+        if (AsPrimaryExpression(element, PrimaryExpressionType::Varargs) != nullptr) {
+            context_->emitInstruction(MakeInstruction(OpCode::ArrayPushVarargs, arrayRegisterID));
+        } else {
+            generateExpression(element);
+            int elementRegisterID = context_->popRegisterID();
+            context_->emitInstruction(MakeInstruction(OpCode::ArrayPush, arrayRegisterID
+                                                      , elementRegisterID));
+        }
+    }
+
+    return;
+}
+
+
+void
+Compiler::generateDictionaryLiteral(const DictionaryLiteral &dictionaryLiteral)
+{
+    int dictionaryRegisterID = context_->pushRegisterID();
+    int sizeHint = GetSizeHint(dictionaryLiteral.elements.getSize());
+    context_->emitInstruction(MakeInstruction(OpCode::NewDictionary, dictionaryRegisterID
+                                              , sizeHint));
+
+    for (const std::pair<Expression *, Expression *> &element : dictionaryLiteral.elements) {
+        int fieldIndex = getFieldIndex(element.first);
+
+        if (fieldIndex < 0) {
+            generateExpression(element.first);
+            isolateOperand(element.second);
+        }
+
+        generateExpression(element.second);
+        int valueRegisterID = context_->popRegisterID();
+        int keyRegisterID = fieldIndex < 0 ? context_->popRegisterID() : 0;
+        emitSetElement(dictionaryRegisterID, keyRegisterID, fieldIndex, valueRegisterID);
+    }
+
+    return;
+}
+
+
+void
+Compiler::generateFunctionLiteral(const FunctionLiteral &functionLiteral)
+{
+    std::vector<Function> &functions = context_->getFunction()->functions;
+    functions.emplace_back();
+    auto functionIndex = static_cast<std::int32_t>(functions.size() - 1);
+    generateFunction(functionLiteral, &functions.back());
+    int closureRegisterID = context_->pushRegisterID();
+    context_->emitInstruction(MakeWideInstruction(OpCode::NewClosure, closureRegisterID
+                                                  , functionIndex));
+    return;
+}
+
+
+void
+Compiler::generateIncrement(const UnaryExpression &unaryExpression, bool isPrefix)
+{
+    OpCode opCode = unaryExpression.op == MakeTokenType('+', '+') ? OpCode::Increment
+                                                                   : OpCode::Decrement;
+    auto variable = AsPrimaryExpression(unaryExpression.operand
+                                        , PrimaryExpressionType::VariableName);
+
+    if (variable != nullptr) {
+        context_->pushRegisterID(variable->string);
+        int variableRegisterID = context_->popRegisterID();
+
+        if (context_->isCellRegister(variableRegisterID)) {
+            int oldValueRegisterID = context_->pushRegisterID();
+            context_->emitInstruction(MakeInstruction(OpCode::GetCell, oldValueRegisterID
+                                                      , variableRegisterID));
+            int newValueRegisterID = isPrefix ? oldValueRegisterID : context_->pushRegisterID();
+            context_->emitInstruction(MakeInstruction(opCode, newValueRegisterID
+                                                      , oldValueRegisterID));
+            context_->emitInstruction(MakeInstruction(OpCode::SetCell, variableRegisterID
+                                                      , newValueRegisterID));
+
+            if (!isPrefix) {
+                context_->popRegisterID();
+            }
+        } else if (isPrefix) {
+            context_->emitInstruction(MakeInstruction(opCode, variableRegisterID
+                                                      , variableRegisterID));
+            context_->pushRegisterID(variable->string);
+        } else {
+            int resultRegisterID = context_->pushRegisterID();
+            context_->emitInstruction(MakeInstruction(OpCode::Move, resultRegisterID
+                                                      , variableRegisterID));
+            context_->emitInstruction(MakeInstruction(opCode, variableRegisterID
+                                                      , variableRegisterID));
+        }
+
+        return;
+    }
+
+    auto retrieval = dynamic_cast<const RetrievalExpression *>(unaryExpression.operand);
+
+    if (retrieval == nullptr) {
+        throw Error::NonLvalueExpression(*statement_);
+    }
+
+    int fieldIndex = generateRetrievalTarget(*retrieval, nullptr);
+    int keyRegisterID = fieldIndex < 0 ? context_->peekRegisterID(0) : 0;
+    int objectRegisterID = context_->peekRegisterID(fieldIndex < 0 ? 1 : 0);
+    int oldValueRegisterID = context_->pushRegisterID();
+    emitGetElement(oldValueRegisterID, objectRegisterID, keyRegisterID, fieldIndex);
+    int newValueRegisterID = isPrefix ? oldValueRegisterID : context_->pushRegisterID();
+    context_->emitInstruction(MakeInstruction(opCode, newValueRegisterID, oldValueRegisterID));
+    emitSetElement(objectRegisterID, keyRegisterID, fieldIndex, newValueRegisterID);
+
+    if (!isPrefix) {
+        context_->popRegisterID();
+    }
+
+    context_->popRegisterID();
+    popRetrievalTarget(fieldIndex);
+    emitMove(context_->pushRegisterID(), oldValueRegisterID);
+    return;
+}
+
+
+void
+Compiler::generateAssignment(const BinaryExpression &binaryExpression)
+{
+    OpCode opCode = binaryExpression.op == MakeTokenType('=')
+                    ? OpCode::No : BinaryOperatorToOpCode(binaryExpression.op);
+    auto variable = AsPrimaryExpression(binaryExpression.operand1
+                                        , PrimaryExpressionType::VariableName);
+
+    if (variable != nullptr && opCode != OpCode::No
+        && MayWriteVariables(binaryExpression.operand2)) {
+        generateExpression(binaryExpression.operand1);
+        moveToNewRegister();
+        generateExpression(binaryExpression.operand2);
+        int operandRegisterID = context_->popRegisterID();
+        int valueRegisterID = context_->popRegisterID();
+        context_->emitInstruction(MakeInstruction(opCode, valueRegisterID, valueRegisterID
+                                                  , operandRegisterID));
+        context_->pushRegisterID(variable->string);
+        int variableRegisterID = context_->popRegisterID();
+
+        if (context_->isCellRegister(variableRegisterID)) {
+            context_->emitInstruction(MakeInstruction(OpCode::SetCell, variableRegisterID
+                                                      , valueRegisterID));
+            context_->pushRegisterID();
+        } else {
+            emitMove(variableRegisterID, valueRegisterID);
+            context_->pushRegisterID(variable->string);
+        }
+
+        return;
+    }
+
+    if (variable != nullptr) {
+        generateExpression(binaryExpression.operand2);
+        context_->pushRegisterID(variable->string);
+        int variableRegisterID = context_->popRegisterID();
+
+        if (context_->isCellRegister(variableRegisterID)) {
+            int valueRegisterID = context_->peekRegisterID(0);
+
+            if (opCode != OpCode::No) {
+                int oldValueRegisterID = context_->pushRegisterID();
+                context_->emitInstruction(MakeInstruction(OpCode::GetCell, oldValueRegisterID
+                                                          , variableRegisterID));
+                context_->popRegisterID();
+                int operandRegisterID = context_->popRegisterID();
+                valueRegisterID = context_->pushRegisterID();
+                context_->emitInstruction(MakeInstruction(opCode, valueRegisterID
+                                                          , oldValueRegisterID, operandRegisterID));
+            }
+
+            context_->emitInstruction(MakeInstruction(OpCode::SetCell, variableRegisterID
+                                                      , valueRegisterID));
+            return;
+        }
+
+        int valueRegisterID = context_->popRegisterID();
+        context_->pushRegisterID(variable->string);
+
+        if (opCode == OpCode::No) {
+            emitMove(variableRegisterID, valueRegisterID);
+        } else {
+            context_->emitInstruction(MakeInstruction(opCode, variableRegisterID
+                                                      , variableRegisterID, valueRegisterID));
+        }
+
+        return;
+    }
+
+    auto retrieval = dynamic_cast<const RetrievalExpression *>(binaryExpression.operand1);
+
+    if (retrieval == nullptr) {
+        throw Error::NonLvalueExpression(*statement_);
+    }
+
+    int fieldIndex = generateRetrievalTarget(*retrieval, binaryExpression.operand2);
+    int keyRegisterID = fieldIndex < 0 ? context_->peekRegisterID(0) : 0;
+    int objectRegisterID = context_->peekRegisterID(fieldIndex < 0 ? 1 : 0);
+    int valueRegisterID;
+
+    if (opCode == OpCode::No) {
+        generateExpression(binaryExpression.operand2);
+        valueRegisterID = context_->peekRegisterID(0);
+    } else {
+        valueRegisterID = context_->pushRegisterID();
+        emitGetElement(valueRegisterID, objectRegisterID, keyRegisterID, fieldIndex);
+        generateExpression(binaryExpression.operand2);
+        int operandRegisterID = context_->popRegisterID();
+        context_->emitInstruction(MakeInstruction(opCode, valueRegisterID, valueRegisterID
+                                                  , operandRegisterID));
+    }
+
+    emitSetElement(objectRegisterID, keyRegisterID, fieldIndex, valueRegisterID);
+    context_->popRegisterID();
+    popRetrievalTarget(fieldIndex);
+    emitMove(context_->pushRegisterID(), valueRegisterID);
+    return;
+}
+
+
+void
+Compiler::generateLogicalExpression(const BinaryExpression &binaryExpression)
+{
+    OpCode jumpOpCode = binaryExpression.op == MakeTokenType('&', '&') ? OpCode::JumpIfFalse
+                                                                       : OpCode::JumpIfTrue;
+    int resultRegisterID = context_->pushRegisterID();
+    generateExpression(binaryExpression.operand1);
+    int operandRegisterID = context_->popRegisterID();
+    context_->emitInstruction(MakeInstruction(OpCode::ToBoolean, resultRegisterID
+                                              , operandRegisterID));
+    int jumpIndex = context_->emitInstruction(MakeInstruction(jumpOpCode, resultRegisterID));
+    generateExpression(binaryExpression.operand2);
+    operandRegisterID = context_->popRegisterID();
+    context_->emitInstruction(MakeInstruction(OpCode::ToBoolean, resultRegisterID
+                                              , operandRegisterID));
+    context_->setJumpTarget(jumpIndex, context_->addLabel());
+    return;
+}
+
+
+int
+Compiler::generateRetrievalTarget(const RetrievalExpression &retrieval
+                                  , const Expression *laterOperand)
+{
+    generateExpression(retrieval.retrievee);
+    int fieldIndex = getFieldIndex(retrieval.key);
+
+    isolateOperand(laterOperand);
+
+    if (fieldIndex < 0) {
+        isolateOperand(retrieval.key);
+        generateExpression(retrieval.key);
+        isolateOperand(laterOperand);
+    }
+
+    return fieldIndex;
+}
+
+
+void
+Compiler::popRetrievalTarget(int fieldIndex)
+{
+    if (fieldIndex < 0) {
+        context_->popRegisterID();
+    }
+
+    context_->popRegisterID();
+    return;
+}
+
+
+void
+Compiler::emitGetElement(int targetRegisterID, int objectRegisterID, int keyRegisterID
+                         , int fieldIndex)
+{
+    if (fieldIndex < 0) {
+        context_->emitInstruction(MakeInstruction(OpCode::GetElement, targetRegisterID
+                                                  , objectRegisterID, keyRegisterID));
+    } else {
+        context_->emitInstruction(MakeInstruction(OpCode::GetField, targetRegisterID
+                                                  , objectRegisterID
+                                                  , context_->addFieldSite(fieldIndex)));
+    }
+
+    return;
+}
+
+
+void
+Compiler::emitSetElement(int objectRegisterID, int keyRegisterID, int fieldIndex
+                         , int valueRegisterID)
+{
+    if (fieldIndex < 0) {
+        context_->emitInstruction(MakeInstruction(OpCode::SetElement, objectRegisterID
+                                                  , keyRegisterID, valueRegisterID));
+    } else {
+        context_->emitInstruction(MakeInstruction(OpCode::SetField, objectRegisterID
+                                                  , context_->addFieldSite(fieldIndex)
+                                                  , valueRegisterID));
+    }
+
+    return;
+}
+
+
+void
+Compiler::emitMove(int targetRegisterID, int sourceRegisterID)
+{
+    if (targetRegisterID == sourceRegisterID) {
+        return;
+    }
+
+    if (sourceRegisterID >= context_->getNumberOfRegisters() && !context_->isLabeled()) {
+        Instruction *instruction = context_->getLastInstruction();
+
+        if (instruction != nullptr && OpCodeSetsA(instruction->opCode)
+            && instruction->a == sourceRegisterID) {
+            instruction->a = targetRegisterID;
+            return;
+        }
+    }
+
+    context_->emitInstruction(MakeInstruction(OpCode::Move, targetRegisterID, sourceRegisterID));
+    return;
+}
+
+
+void
+Compiler::moveToNewRegister()
+{
+    int sourceRegisterID = context_->popRegisterID();
+    emitMove(context_->pushRegisterID(), sourceRegisterID);
+    return;
+}
+
+
+void
+Compiler::isolateOperand(const Expression *laterOperand)
+{
+    if (context_->peekRegisterID(0) < context_->getNumberOfRegisters()
+        && laterOperand != nullptr && MayWriteVariables(laterOperand)) {
+        moveToNewRegister();
+    }
+
+    return;
+}
+
+
+int
+Compiler::getFieldIndex(const Expression *key)
+{
+    auto string = AsPrimaryExpression(key, PrimaryExpressionType::String);
+
+    if (string == nullptr || context_->getNumberOfFieldSites() >= MaxShortOperand) {
+        return -1;
+    }
+
+    int fieldIndex = context_->getStringConstantIndex(string->string
+                                                      , program_->data.strings.getString(string->string));
+    return fieldIndex <= MaxShortOperand ? fieldIndex : -1;
+}
+
+
+int
+Compiler::generateSwitchTable(const ArenaArray<CaseClause> &caseClauses)
+{
+    SwitchTable switchTable;
+    std::vector<std::pair<std::int64_t, int>> integerTargets;
+
+    for (std::size_t i = 0; i < caseClauses.getSize(); ++i) {
+        const Expression *rhs = caseClauses[i].rhs;
+
+        if (rhs == nullptr) {
+            continue;
+        }
+
+        auto integer = AsPrimaryExpression(rhs, PrimaryExpressionType::Integer);
+
+        if (integer != nullptr) {
+            auto value = static_cast<std::int64_t>(integer->integer);
+
+            if (value < -MaxExactInteger || value > MaxExactInteger) {
+                return -1;
+            }
+
+            integerTargets.emplace_back(value, static_cast<int>(i));
+            continue;
+        }
+
+        auto string = AsPrimaryExpression(rhs, PrimaryExpressionType::String);
+
+        if (string == nullptr) {
+            return -1;
+        }
+
+        switchTable.stringTargets.emplace(program_->data.strings.getString(string->string)
+                                          , static_cast<int>(i));
+    }
+
+    if (integerTargets.empty() && switchTable.stringTargets.empty()) {
+        return -1;
+    }
+
+    if (!integerTargets.empty()) {
+        std::sort(integerTargets.begin(), integerTargets.end());
+        auto end = std::unique(integerTargets.begin(), integerTargets.end()
+                               , [] (const std::pair<std::int64_t, int> &integerTarget1
+                                     , const std::pair<std::int64_t, int> &integerTarget2) -> bool {
+            return integerTarget1.first == integerTarget2.first;
+        });
+
+        integerTargets.erase(end, integerTargets.end());
+
+        std::int64_t minInteger = integerTargets.front().first;
+        auto range = static_cast<std::size_t>(integerTargets.back().first - minInteger) + 1;
+
+        if (range <= 2 * integerTargets.size()) {
+            switchTable.minInteger = minInteger;
+            switchTable.denseTargets.assign(range, -1);
+
+            for (const std::pair<std::int64_t, int> &integerTarget : integerTargets) {
+                switchTable.denseTargets[integerTarget.first - minInteger] = integerTarget.second;
+            }
+        } else {
+            switchTable.sparseTargets = std::move(integerTargets);
+        }
+    }
+
+    std::vector<SwitchTable> &switchTables = context_->getFunction()->switchTables;
+    switchTables.push_back(std::move(switchTable));
+    return static_cast<int>(switchTables.size()) - 1;
+}
+
+
+void
+Compiler::visitPrimaryExpression(const PrimaryExpression &primaryExpression)
+{
+    switch (primaryExpression.type) {
+    case PrimaryExpressionType::Null:
+        context_->emitInstruction(MakeInstruction(OpCode::LoadNull, context_->pushRegisterID()));
+        return;
+
+    case PrimaryExpressionType::Boolean:
+        context_->emitInstruction(MakeInstruction(OpCode::LoadBoolean, context_->pushRegisterID()
+                                                  , primaryExpression.boolean));
+        return;
+
+    case PrimaryExpressionType::Integer: {
+            auto integer = static_cast<std::int64_t>(primaryExpression.integer);
+            int registerID = context_->pushRegisterID();
+
+            if (integer >= std::numeric_limits<std::int32_t>::min()
+                && integer <= std::numeric_limits<std::int32_t>::max()) {
+                context_->emitInstruction(MakeWideInstruction(OpCode::LoadInteger, registerID
+                                                              , static_cast<std::int32_t>(integer)));
+            } else {
+                context_->emitInstruction(MakeWideInstruction(OpCode::LoadConstant, registerID
+                                                              , context_->getIntegerConstantIndex(integer)));
+            }
+
+            return;
+        }
+
+    case PrimaryExpressionType::FloatingPoint: {
+            int constantIndex = context_->getFloatingPointConstantIndex(primaryExpression.floatingPoint);
+            context_->emitInstruction(MakeWideInstruction(OpCode::LoadConstant
+                                                          , context_->pushRegisterID(), constantIndex));
+            return;
+        }
+
+    case PrimaryExpressionType::String: {
+            SymbolID string = primaryExpression.string;
+            int constantIndex = context_->getStringConstantIndex(string
+                                                                 , program_->data.strings.getString(string));
+            context_->emitInstruction(MakeWideInstruction(OpCode::LoadConstant
+                                                          , context_->pushRegisterID(), constantIndex));
+            return;
+        }
+
+    case PrimaryExpressionType::VariableName: {
+            context_->pushRegisterID(primaryExpression.string);
+            int variableRegisterID = context_->peekRegisterID(0);
+
+            if (context_->isCellRegister(variableRegisterID)) {
+                context_->popRegisterID();
+                context_->emitInstruction(MakeInstruction(OpCode::GetCell
+                                                          , context_->pushRegisterID()
+                                                          , variableRegisterID));
+            }
+
+            return;
+        }
+
+    case PrimaryExpressionType::ArrayLiteral:
+        generateArrayLiteral(*primaryExpression.arrayLiteral);
+        return;
+
+    case PrimaryExpressionType::DictionaryLiteral:
+        generateDictionaryLiteral(*primaryExpression.dictionaryLiteral);
+        return;
+
+    case PrimaryExpressionType::FunctionLiteral:
+        generateFunctionLiteral(*primaryExpression.functionLiteral);
+        return;
+
+    case PrimaryExpressionType::This:
+        context_->emitInstruction(MakeInstruction(OpCode::LoadThis, context_->pushRegisterID()));
+        return;
+
+    case PrimaryExpressionType::Varargs: {
+            int arrayRegisterID = context_->pushRegisterID();
+            context_->emitInstruction(MakeInstruction(OpCode::NewArray, arrayRegisterID));
+            context_->emitInstruction(MakeInstruction(OpCode::ArrayPushVarargs, arrayRegisterID));
+            return;
+        }
+
+    default:
+        return;
+    }
+}
+
+
+void
+Compiler::visitUnaryExpression(const UnaryExpression &unaryExpression)
+{
+    switch (unaryExpression.op) {
+    case MakeTokenType('+', '+'):
+    case MakeTokenType('-', '-'):
+        generateIncrement(unaryExpression, unaryExpression.type == UnaryExpressionType::Prefix);
+        return;
+
+    default: {
+            generateExpression(unaryExpression.operand);
+            int operandRegisterID = context_->popRegisterID();
+            context_->emitInstruction(MakeInstruction(UnaryOperatorToOpCode(unaryExpression.op)
+                                                      , context_->pushRegisterID()
+                                                      , operandRegisterID));
+            return;
+        }
+    }
+}
+
+
+void
+Compiler::visitBinaryExpression(const BinaryExpression &binaryExpression)
+{
+    switch (binaryExpression.op) {
+    case MakeTokenType(','):
+        generateDiscardedExpression(binaryExpression.operand1);
+        generateExpression(binaryExpression.operand2);
+        return;
+
+    case MakeTokenType('='):
+    case MakeTokenType('|', '='):
+    case MakeTokenType('^', '='):
+    case MakeTokenType('&', '='):
+    case MakeTokenType('<', '<', '='):
+    case MakeTokenType('>', '>', '='):
+    case MakeTokenType('+', '='):
+    case MakeTokenType('-', '='):
+    case MakeTokenType('*', '='):
+    case MakeTokenType('/', '='):
+    case MakeTokenType('%', '='):
+        generateAssignment(binaryExpression);
+        return;
+
+    case MakeTokenType('|', '|'):
+    case MakeTokenType('&', '&'):
+        generateLogicalExpression(binaryExpression);
+        return;
+
+    default: {
+            generateExpression(binaryExpression.operand1);
+            isolateOperand(binaryExpression.operand2);
+            generateExpression(binaryExpression.operand2);
+            int operandRegisterID2 = context_->popRegisterID();
+            int operandRegisterID1 = context_->popRegisterID();
+            int resultRegisterID = context_->pushRegisterID();
+
+            switch (binaryExpression.op) {
+            case MakeTokenType('>'):
+                context_->emitInstruction(MakeInstruction(OpCode::Less, resultRegisterID
+                                                          , operandRegisterID2, operandRegisterID1));
+                return;
+
+            case MakeTokenType('>', '='):
+                context_->emitInstruction(MakeInstruction(OpCode::LessEqual, resultRegisterID
+                                                          , operandRegisterID2, operandRegisterID1));
+                return;
+
+            default:
+                context_->emitInstruction(MakeInstruction(BinaryOperatorToOpCode(binaryExpression.op)
+                                                          , resultRegisterID, operandRegisterID1
+                                                          , operandRegisterID2));
+                return;
+            }
+        }
+    }
+}
+
+
+void
+Compiler::visitTernaryExpression(const TernaryExpression &ternaryExpression)
+{
+    int resultRegisterID = context_->pushRegisterID();
+    generateExpression(ternaryExpression.operand1);
+    int conditionRegisterID = context_->popRegisterID();
+    int jumpIndex1 = context_->emitInstruction(MakeInstruction(OpCode::JumpIfFalse
+                                                               , conditionRegisterID));
+    generateExpression(ternaryExpression.operand2);
+    emitMove(resultRegisterID, context_->popRegisterID());
+    int jumpIndex2 = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    context_->setJumpTarget(jumpIndex1, context_->addLabel());
+    generateExpression(ternaryExpression.operand3);
+    emitMove(resultRegisterID, context_->popRegisterID());
+    context_->setJumpTarget(jumpIndex2, context_->addLabel());
+    return;
+}
+
+
+void
+Compiler::visitRetrievalExpression(const RetrievalExpression &retrievalExpression)
+{
+    int fieldIndex = generateRetrievalTarget(retrievalExpression, nullptr);
+    int keyRegisterID = fieldIndex < 0 ? context_->popRegisterID() : 0;
+    int objectRegisterID = context_->popRegisterID();
+    emitGetElement(context_->pushRegisterID(), objectRegisterID, keyRegisterID, fieldIndex);
+    return;
+}
+
+
+void
+Compiler::visitInvocationExpression(const InvocationExpression &invocationExpression)
+{
+    int baseRegisterID = context_->pushRegisterID();
+    auto retrieval = dynamic_cast<const RetrievalExpression *>(invocationExpression.invokee);
+    bool hasThis = retrieval != nullptr;
+
+    if (hasThis) {
+        generateExpression(retrieval->retrievee);
+        moveToNewRegister();
+        int fieldIndex = getFieldIndex(retrieval->key);
+
+        if (fieldIndex < 0) {
+            generateExpression(retrieval->key);
+            int keyRegisterID = context_->popRegisterID();
+            emitGetElement(baseRegisterID, baseRegisterID + 1, keyRegisterID, fieldIndex);
+        } else {
+            emitGetElement(baseRegisterID, baseRegisterID + 1, 0, fieldIndex);
+        }
+    } else {
+        generateExpression(invocationExpression.invokee);
+        emitMove(baseRegisterID, context_->popRegisterID());
+        context_->pushRegisterID();
+    }
+
+    const ArenaArray<Expression *> &arguments = invocationExpression.arguments;
+    bool hasVarargs = false;
+
+    for (const Expression *argument : arguments) {
+        if (AsPrimaryExpression(argument, PrimaryExpressionType::Varargs) != nullptr) {
+            hasVarargs = true;
+            break;
+        }
+    }
+
+    int numberOfArguments;
+
+    if (hasVarargs) {
+        int arrayRegisterID = context_->pushRegisterID();
+        int sizeHint = GetSizeHint(arguments.getSize());
+        context_->emitInstruction(MakeInstruction(OpCode::NewArray, arrayRegisterID, sizeHint));
+
+        for (const Expression *argument : arguments) {
+            if (AsPrimaryExpression(argument, PrimaryExpressionType::Varargs) != nullptr) {
+                context_->emitInstruction(MakeInstruction(OpCode::ArrayPushVarargs
+                                                          , arrayRegisterID));
+            } else {
+                generateExpression(argument);
+                int argumentRegisterID = context_->popRegisterID();
+                context_->emitInstruction(MakeInstruction(OpCode::ArrayPush, arrayRegisterID
+                                                          , argumentRegisterID));
+            }
+        }
+
+        context_->emitInstruction(MakeInstruction(OpCode::CallWithArray, baseRegisterID, 0
+                                                  , hasThis));
+        numberOfArguments = 1;
+    } else {
+        for (const Expression *argument : arguments) {
+            generateExpression(argument);
+            moveToNewRegister();
+        }
+
+        numberOfArguments = arguments.getSize();
+        context_->emitInstruction(MakeInstruction(OpCode::Call, baseRegisterID, numberOfArguments
+                                                  , hasThis));
+    }
+
+    for (int i = numberOfArguments + 2; i >= 1; --i) {
+        context_->popRegisterID();
+    }
+
+    context_->pushRegisterID();
+    return;
+}
+
+
+void
+Compiler::visitExpressionStatement(const ExpressionStatement &expressionStatement)
+{
+    statement_ = &expressionStatement;
+    context_->setLineNumber(expressionStatement.lineNumber);
+    generateDiscardedExpression(expressionStatement.expression);
+    return;
+}
+
+
+void
+Compiler::visitAutoStatement(const AutoStatement &autoStatement)
+{
+    statement_ = &autoStatement;
+    context_->setLineNumber(autoStatement.lineNumber);
+
+    for (const VariableDeclarator &variableDeclarator : autoStatement.variableDeclarators) {
+        addVariable(variableDeclarator.name);
+        int variableRegisterID = context_->getNumberOfRegisters() - 1;
+
+        if (context_->isCellRegister(variableRegisterID)) {
+            context_->emitInstruction(MakeInstruction(OpCode::LoadNull, variableRegisterID));
+            context_->emitInstruction(MakeInstruction(OpCode::NewCell, variableRegisterID
+                                                      , variableRegisterID));
+
+            if (variableDeclarator.initializer != nullptr) {
+                generateExpression(variableDeclarator.initializer);
+                context_->emitInstruction(MakeInstruction(OpCode::SetCell, variableRegisterID
+                                                          , context_->popRegisterID()));
+            }
+        } else if (variableDeclarator.initializer == nullptr) {
+            context_->emitInstruction(MakeInstruction(OpCode::LoadNull, variableRegisterID));
+        } else {
+            generateExpression(variableDeclarator.initializer);
+            emitMove(variableRegisterID, context_->popRegisterID());
+        }
+    }
+
+    return;
+}
+
+
+void
+Compiler::visitBreakStatement(const BreakStatement &breakStatement)
+{
+    statement_ = &breakStatement;
+    context_->setLineNumber(breakStatement.lineNumber);
+    int jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+
+    if (!context_->addBreakJump(jumpIndex)) {
+        throw Error::MisplacedStatement(breakStatement);
+    }
+
+    return;
+}
+
+
+void
+Compiler::visitContinueStatement(const ContinueStatement &continueStatement)
+{
+    statement_ = &continueStatement;
+    context_->setLineNumber(continueStatement.lineNumber);
+    int jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+
+    if (!context_->addContinueJump(jumpIndex)) {
+        throw Error::MisplacedStatement(continueStatement);
+    }
+
+    return;
+}
+
+
+void
+Compiler::visitReturnStatement(const ReturnStatement &returnStatement)
+{
+    statement_ = &returnStatement;
+    context_->setLineNumber(returnStatement.lineNumber);
+
+    if (returnStatement.result == nullptr) {
+        context_->emitInstruction(MakeInstruction(OpCode::ReturnNull));
+    } else {
+        generateExpression(returnStatement.result);
+        context_->emitInstruction(MakeInstruction(OpCode::Return, context_->popRegisterID()));
+    }
+
+    return;
+}
+
+
+void
+Compiler::visitIfStatement(const IfStatement &ifStatement)
+{
+    statement_ = &ifStatement;
+    context_->setLineNumber(ifStatement.lineNumber);
+    int numberOfRegisters = context_->getNumberOfRegisters();
+    generateExpression(ifStatement.condition);
+    int jumpIndex1 = context_->emitInstruction(MakeInstruction(OpCode::JumpIfFalse
+                                                               , context_->popRegisterID()));
+    generateStatements(ifStatement.thenBody);
+
+    if (ifStatement.elseBody.isEmpty()) {
+        context_->setJumpTarget(jumpIndex1, context_->addLabel());
+    } else {
+        int jumpIndex2 = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+        context_->setJumpTarget(jumpIndex1, context_->addLabel());
+        generateStatements(ifStatement.elseBody);
+        context_->setJumpTarget(jumpIndex2, context_->addLabel());
+    }
+
+    context_->deleteRegisters(numberOfRegisters);
+    return;
+}
+
+
+void
+Compiler::visitSwitchStatement(const SwitchStatement &switchStatement)
+{
+    statement_ = &switchStatement;
+    context_->setLineNumber(switchStatement.lineNumber);
+    generateExpression(switchStatement.lhs);
+    int lhsRegisterID = context_->peekRegisterID(0);
+    const ArenaArray<CaseClause> &caseClauses = switchStatement.caseClauses;
+    std::vector<int> caseJumpIndexes(caseClauses.getSize(), -1);
+    std::size_t defaultCaseClauseIndex = caseClauses.getSize();
+
+    for (std::size_t i = 0; i < caseClauses.getSize(); ++i) {
+        if (caseClauses[i].rhs == nullptr) {
+            defaultCaseClauseIndex = i;
+        }
+    }
+
+    int switchTableIndex = generateSwitchTable(caseClauses);
+    int defaultJumpIndex = -1;
+
+    if (switchTableIndex >= 0) {
+        context_->emitInstruction(MakeWideInstruction(OpCode::Switch, lhsRegisterID
+                                                      , switchTableIndex));
+        context_->popRegisterID();
+    } else {
+        for (std::size_t i = 0; i < caseClauses.getSize(); ++i) {
+            const CaseClause &caseClause = caseClauses[i];
+
+            if (caseClause.rhs != nullptr) {
+                generateExpression(caseClause.rhs);
+                int rhsRegisterID = context_->popRegisterID();
+                int resultRegisterID = context_->pushRegisterID();
+                context_->emitInstruction(MakeInstruction(OpCode::Equal, resultRegisterID
+                                                          , lhsRegisterID, rhsRegisterID));
+                caseJumpIndexes[i] = context_->emitInstruction(MakeInstruction(OpCode::JumpIfTrue
+                                                                               , context_->popRegisterID()));
+            }
+        }
+
+        context_->popRegisterID();
+        defaultJumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    }
+
+    context_->beginSwitch();
+    std::vector<int> caseLabels(caseClauses.getSize());
+
+    for (std::size_t i = 0; i < caseClauses.getSize(); ++i) {
+        caseLabels[i] = context_->addLabel();
+        int numberOfRegisters = context_->getNumberOfRegisters();
+        generateStatements(caseClauses[i].body);
+        context_->deleteRegisters(numberOfRegisters);
+    }
+
+    int endLabel = context_->addLabel();
+    int defaultLabel = defaultCaseClauseIndex == caseClauses.getSize()
+                       ? endLabel : caseLabels[defaultCaseClauseIndex];
+
+    if (switchTableIndex >= 0) {
+        ResolveSwitchTable(&context_->getFunction()->switchTables[switchTableIndex], caseLabels
+                           , defaultLabel);
+    } else {
+        for (std::size_t i = 0; i < caseClauses.getSize(); ++i) {
+            if (caseJumpIndexes[i] >= 0) {
+                context_->setJumpTarget(caseJumpIndexes[i], caseLabels[i]);
+            }
+        }
+
+        context_->setJumpTarget(defaultJumpIndex, defaultLabel);
+    }
+
+    context_->endSwitch(endLabel);
+    return;
+}
+
+
+void
+Compiler::visitWhileStatement(const WhileStatement &whileStatement)
+{
+    statement_ = &whileStatement;
+    context_->setLineNumber(whileStatement.lineNumber);
+    int numberOfRegisters = context_->getNumberOfRegisters();
+    context_->beginLoop();
+    int jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    int bodyLabel = context_->addLabel();
+    generateStatements(whileStatement.body);
+    context_->deleteRegisters(numberOfRegisters);
+    int conditionLabel = context_->addLabel();
+    context_->setJumpTarget(jumpIndex, conditionLabel);
+    context_->setLineNumber(whileStatement.lineNumber);
+    generateExpression(whileStatement.condition);
+    jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::JumpIfTrue
+                                                          , context_->popRegisterID()));
+    context_->setJumpTarget(jumpIndex, bodyLabel);
+    context_->endLoop(conditionLabel, context_->addLabel());
+    return;
+}
+
+
+void
+Compiler::visitDoWhileStatement(const DoWhileStatement &doWhileStatement)
+{
+    statement_ = &doWhileStatement;
+    int numberOfRegisters = context_->getNumberOfRegisters();
+    context_->beginLoop();
+    int bodyLabel = context_->addLabel();
+    generateStatements(doWhileStatement.body);
+    int conditionLabel = context_->addLabel();
+    statement_ = &doWhileStatement;
+    context_->setLineNumber(doWhileStatement.lineNumber);
+    generateExpression(doWhileStatement.condition);
+    int jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::JumpIfTrue
+                                                              , context_->popRegisterID()));
+    context_->setJumpTarget(jumpIndex, bodyLabel);
+    context_->endLoop(conditionLabel, context_->addLabel());
+    context_->deleteRegisters(numberOfRegisters);
+    return;
+}
+
+
+void
+Compiler::visitForStatement(const ForStatement &forStatement)
+{
+    statement_ = &forStatement;
+    context_->setLineNumber(forStatement.lineNumber);
+    int numberOfRegisters1 = context_->getNumberOfRegisters();
+
+    if (forStatement.initialization != nullptr) {
+        forStatement.initialization->acceptVisit(this);
+    }
+
+    int numberOfRegisters2 = context_->getNumberOfRegisters();
+    context_->beginLoop();
+    int jumpIndex = -1;
+
+    if (forStatement.condition != nullptr) {
+        jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    }
+
+    int bodyLabel = context_->addLabel();
+    generateStatements(forStatement.body);
+    context_->deleteRegisters(numberOfRegisters2);
+    int iterationLabel = context_->addLabel();
+    statement_ = &forStatement;
+    context_->setLineNumber(forStatement.lineNumber);
+
+    if (forStatement.iteration != nullptr) {
+        generateDiscardedExpression(forStatement.iteration);
+    }
+
+    if (forStatement.condition == nullptr) {
+        jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    } else {
+        context_->setJumpTarget(jumpIndex, context_->addLabel());
+        generateExpression(forStatement.condition);
+        jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::JumpIfTrue
+                                                              , context_->popRegisterID()));
+    }
+
+    context_->setJumpTarget(jumpIndex, bodyLabel);
+    context_->endLoop(iterationLabel, context_->addLabel());
+    context_->deleteRegisters(numberOfRegisters1);
+    return;
+}
+
+
+void
+Compiler::visitForeachStatement(const ForeachStatement &foreachStatement)
 {
-    CompilationContext(const CompilationContext &) = delete;
-    CompilationContext &operator=(const CompilationContext &) = delete;
+    statement_ = &foreachStatement;
+    context_->setLineNumber(foreachStatement.lineNumber);
+    int numberOfRegisters1 = context_->getNumberOfRegisters();
+    addVariable(foreachStatement.variableName1);
+    addVariable(foreachStatement.variableName2);
 
-public:
-    explicit CompilationContext(CompilationContext *);
+    for (int i = 0; i < 2; ++i) {
+        context_->addRegister(NoSymbolID);
+    }
 
-    int getSuperRegisterID(const std::string *) const;
-    int getNumberOfRegisters() const;
-    void addRegister(const std::string *);
-    void deleteRegisters(int);
-    void pushRegisterID(const std::string *);
-    void pushRegisterID();
-    int popRegisterID();
+    int iteratorRegisterID = numberOfRegisters1;
+    int collectionRegisterID = numberOfRegisters1 + 2;
+    int cursorRegisterID = numberOfRegisters1 + 3;
+    generateExpression(foreachStatement.collection);
+    emitMove(collectionRegisterID, context_->popRegisterID());
+    context_->emitInstruction(MakeWideInstruction(OpCode::LoadInteger, cursorRegisterID, 0));
+    int numberOfRegisters2 = context_->getNumberOfRegisters();
+    context_->beginLoop();
+    int jumpIndex = context_->emitInstruction(MakeInstruction(OpCode::Jump));
+    int bodyLabel = context_->addLabel();
 
-private:
-    CompilationContext *const super_;
-    std::vector<const std::string *> registerIDToName_;
-    std::vector<int> registerIDs_;
+    for (int i = 0; i < 2; ++i) {
+        if (context_->isCellRegister(iteratorRegisterID + i)) {
+            context_->emitInstruction(MakeInstruction(OpCode::NewCell, iteratorRegisterID + i
+                                                      , iteratorRegisterID + i));
+        }
+    }
+
+    generateStatements(foreachStatement.body);
+    context_->deleteRegisters(numberOfRegisters2);
+    int iterationLabel = context_->addLabel();
+    context_->setJumpTarget(jumpIndex, iterationLabel);
+    context_->setLineNumber(foreachStatement.lineNumber);
+    context_->emitInstruction(MakeWideInstruction(OpCode::ForeachNext, iteratorRegisterID
+                                                  , bodyLabel));
+    context_->endLoop(iterationLabel, context_->addLabel());
+    context_->deleteRegisters(numberOfRegisters1);
+    return;
+}
 
-    int getRegisterID(const std::string *) const;
-};
 
+CompilationContext::CompilationContext(CompilationContext *super, Function *function)
+  : super_(super),
+    function_(function),
+    lineNumber_(0),
+    lastLabel_(-1)
+{
+}
 
-CompilationContext::CompilationContext(CompilationContext *super)
-  : super_(super)
+
+Function *
+CompilationContext::getFunction() const
 {
+    return function_;
 }
 
 
 int
-CompilationContext::getSuperRegisterID(const std::string *superRegisterName) const
+CompilationContext::getSuperRegisterID(SymbolID superRegisterName) const
 {
     return super_->getRegisterID(superRegisterName);
 }
 
 
+bool
+CompilationContext::isSuperCellRegister(SymbolID superRegisterName) const
+{
+    return super_->isCellRegister(super_->getRegisterID(superRegisterName));
+}
+
+
 int
 CompilationContext::getNumberOfRegisters() const
 {
@@ -52,31 +1285,80 @@ CompilationContext::getNumberOfRegisters() const
 
 
 void
-CompilationContext::addRegister(const std::string *registerName)
+CompilationContext::addRegister(SymbolID registerName, bool isCell)
 {
+    int registerID = static_cast<int>(registerIDToName_.size());
+
+    if (registerID == MaxNumberOfRegisters) {
+        throw std::length_error("too many registers");
+    }
+
+    int shadowedRegisterID = -1;
+
+    if (registerName != NoSymbolID) {
+        std::pair<std::unordered_map<SymbolID, int>::iterator
+                  , bool> result = nameToRegisterID_.emplace(registerName, registerID);
+
+        if (!result.second) {
+            shadowedRegisterID = result.first->second;
+            result.first->second = registerID;
+        }
+    }
+
     registerIDToName_.push_back(registerName);
+    registerIDToShadowedRegisterID_.push_back(shadowedRegisterID);
+    registerIDToCellFlag_.push_back(isCell);
+
+    if (function_->numberOfRegisters <= registerID) {
+        function_->numberOfRegisters = registerID + 1;
+    }
+}
+
+
+bool
+CompilationContext::isCellRegister(int registerID) const
+{
+    return registerIDToCellFlag_[registerID];
 }
 
 
 void
 CompilationContext::deleteRegisters(int numberOfRegisters)
 {
-    registerIDToName_.erase(registerIDToName_.begin() + numberOfRegisters, registerIDToName_.end());
+    while (static_cast<int>(registerIDToName_.size()) > numberOfRegisters) {
+        SymbolID registerName = registerIDToName_.back();
+
+        if (registerName != NoSymbolID) {
+            int shadowedRegisterID = registerIDToShadowedRegisterID_.back();
+
+            if (shadowedRegisterID < 0) {
+                nameToRegisterID_.erase(registerName);
+            } else {
+                nameToRegisterID_[registerName] = shadowedRegisterID;
+            }
+        }
+
+        registerIDToName_.pop_back();
+        registerIDToShadowedRegisterID_.pop_back();
+        registerIDToCellFlag_.pop_back();
+    }
 }
 
 
 void
-CompilationContext::pushRegisterID(const std::string *registerName)
+CompilationContext::pushRegisterID(SymbolID registerName)
 {
     registerIDs_.push_back(getRegisterID(registerName));
 }
 
 
-void
+int
 CompilationContext::pushRegisterID()
 {
-    addRegister(nullptr);
-    registerIDs_.push_back(static_cast<int>(registerIDToName_.size()) - 1);
+    addRegister(NoSymbolID);
+    int registerID = static_cast<int>(registerIDToName_.size()) - 1;
+    registerIDs_.push_back(registerID);
+    return registerID;
 }
 
 
@@ -86,8 +1368,10 @@ CompilationContext::popRegisterID()
     int registerID = registerIDs_.back();
     registerIDs_.pop_back();
 
-    if (registerIDToName_[registerID] == nullptr) {
+    if (registerIDToName_[registerID] == NoSymbolID) {
         registerIDToName_.pop_back();
+        registerIDToShadowedRegisterID_.pop_back();
+        registerIDToCellFlag_.pop_back();
     }
 
     return registerID;
@@ -95,13 +1379,485 @@ CompilationContext::popRegisterID()
 
 
 int
-CompilationContext::getRegisterID(const std::string *registerName) const
+CompilationContext::peekRegisterID(int depth) const
+{
+    return registerIDs_[registerIDs_.size() - 1 - depth];
+}
+
+
+void
+CompilationContext::setLineNumber(int lineNumber)
+{
+    lineNumber_ = lineNumber;
+}
+
+
+int
+CompilationContext::emitInstruction(Instruction instruction)
+{
+    function_->code.push_back(instruction);
+    function_->lineNumbers.push_back(lineNumber_);
+    return static_cast<int>(function_->code.size()) - 1;
+}
+
+
+void
+CompilationContext::deleteLastInstruction()
+{
+    function_->code.pop_back();
+    function_->lineNumbers.pop_back();
+}
+
+
+Instruction *
+CompilationContext::getLastInstruction()
+{
+    return function_->code.empty() ? nullptr : &function_->code.back();
+}
+
+
+int
+CompilationContext::addLabel()
+{
+    lastLabel_ = static_cast<int>(function_->code.size());
+    return lastLabel_;
+}
+
+
+bool
+CompilationContext::isLabeled() const
+{
+    return lastLabel_ == static_cast<int>(function_->code.size());
+}
+
+
+void
+CompilationContext::setJumpTarget(int instructionIndex, int label)
+{
+    SetWideOperand(&function_->code[instructionIndex], label);
+}
+
+
+int
+CompilationContext::getIntegerConstantIndex(std::int64_t integer)
+{
+    std::pair<std::unordered_map<std::int64_t, int>::iterator
+              , bool> result = integerToConstantIndex_.emplace(integer, function_->constants.size());
+
+    if (result.second) {
+        Constant &constant = function_->constants.emplace_back();
+        constant.type = ConstantType::Integer;
+        constant.integer = integer;
+    }
+
+    return result.first->second;
+}
+
+
+int
+CompilationContext::getFloatingPointConstantIndex(double floatingPoint)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &floatingPoint, sizeof bits);
+    std::pair<std::unordered_map<std::uint64_t, int>::iterator
+              , bool> result = floatingPointToConstantIndex_.emplace(bits, function_->constants.size());
+
+    if (result.second) {
+        Constant &constant = function_->constants.emplace_back();
+        constant.type = ConstantType::FloatingPoint;
+        constant.floatingPoint = floatingPoint;
+    }
+
+    return result.first->second;
+}
+
+
+int
+CompilationContext::getStringConstantIndex(SymbolID symbolID, std::string_view string)
+{
+    std::pair<std::unordered_map<SymbolID, int>::iterator
+              , bool> result = stringToConstantIndex_.emplace(symbolID, function_->constants.size());
+
+    if (result.second) {
+        Constant &constant = function_->constants.emplace_back();
+        constant.type = ConstantType::String;
+        constant.string = string;
+    }
+
+    return result.first->second;
+}
+
+
+int
+CompilationContext::getNumberOfFieldSites() const
+{
+    return static_cast<int>(function_->fieldKeyIndexes.size());
+}
+
+
+int
+CompilationContext::addFieldSite(int keyIndex)
+{
+    function_->fieldKeyIndexes.push_back(keyIndex);
+    return static_cast<int>(function_->fieldKeyIndexes.size()) - 1;
+}
+
+
+void
+CompilationContext::beginLoop()
+{
+    breakJumpLists_.emplace_back();
+    continueJumpLists_.emplace_back();
+}
+
+
+void
+CompilationContext::endLoop(int continueLabel, int breakLabel)
+{
+    for (int jumpIndex : continueJumpLists_.back()) {
+        setJumpTarget(jumpIndex, continueLabel);
+    }
+
+    continueJumpLists_.pop_back();
+    endSwitch(breakLabel);
+}
+
+
+void
+CompilationContext::beginSwitch()
+{
+    breakJumpLists_.emplace_back();
+}
+
+
+void
+CompilationContext::endSwitch(int breakLabel)
+{
+    for (int jumpIndex : breakJumpLists_.back()) {
+        setJumpTarget(jumpIndex, breakLabel);
+    }
+
+    breakJumpLists_.pop_back();
+}
+
+
+bool
+CompilationContext::addBreakJump(int instructionIndex)
+{
+    if (breakJumpLists_.empty()) {
+        return false;
+    }
+
+    breakJumpLists_.back().push_back(instructionIndex);
+    return true;
+}
+
+
+bool
+CompilationContext::addContinueJump(int instructionIndex)
+{
+    if (continueJumpLists_.empty()) {
+        return false;
+    }
+
+    continueJumpLists_.back().push_back(instructionIndex);
+    return true;
+}
+
+
+int
+CompilationContext::getRegisterID(SymbolID registerName) const
+{
+    return nameToRegisterID_.find(registerName)->second;
+}
+
+
+namespace {
+
+const PrimaryExpression *
+AsPrimaryExpression(const Expression *expression, PrimaryExpressionType primaryExpressionType)
+{
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(expression);
+
+    if (primaryExpression == nullptr || primaryExpression->type != primaryExpressionType) {
+        return nullptr;
+    }
+
+    return primaryExpression;
+}
+
+
+bool
+MayWriteVariables(const Expression *expression)
 {
-    for (int registerID = static_cast<int>(registerIDToName_.size()) - 1;; --registerID) {
-        if (registerIDToName_[registerID] == registerName) {
-            return registerID;
+    // Calls are left out: variables a callee can write are cells, which are always read into
+    // temporary registers.
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(expression);
+
+    if (primaryExpression != nullptr) {
+        switch (primaryExpression->type) {
+        case PrimaryExpressionType::ArrayLiteral:
+            for (const Expression *element : primaryExpression->arrayLiteral->elements) {
+                if (MayWriteVariables(element)) {
+                    return true;
+                }
+            }
+
+            return false;
+
+        case PrimaryExpressionType::DictionaryLiteral:
+            for (const auto &element : primaryExpression->dictionaryLiteral->elements) {
+                if (MayWriteVariables(element.first) || MayWriteVariables(element.second)) {
+                    return true;
+                }
+            }
+
+            return false;
+
+        default:
+            return false;
+        }
+    }
+
+    auto unaryExpression = dynamic_cast<const UnaryExpression *>(expression);
+
+    if (unaryExpression != nullptr) {
+        return unaryExpression->op == MakeTokenType('+', '+')
+               || unaryExpression->op == MakeTokenType('-', '-')
+               || MayWriteVariables(unaryExpression->operand);
+    }
+
+    auto binaryExpression = dynamic_cast<const BinaryExpression *>(expression);
+
+    if (binaryExpression != nullptr) {
+        switch (binaryExpression->op) {
+        case MakeTokenType('='):
+        case MakeTokenType('|', '='):
+        case MakeTokenType('^', '='):
+        case MakeTokenType('&', '='):
+        case MakeTokenType('<', '<', '='):
+        case MakeTokenType('>', '>', '='):
+        case MakeTokenType('+', '='):
+        case MakeTokenType('-', '='):
+        case MakeTokenType('*', '='):
+        case MakeTokenType('/', '='):
+        case MakeTokenType('%', '='):
+            return true;
+
+        default:
+            return MayWriteVariables(binaryExpression->operand1)
+                   || MayWriteVariables(binaryExpression->operand2);
+        }
+    }
+
+    auto ternaryExpression = dynamic_cast<const TernaryExpression *>(expression);
+
+    if (ternaryExpression != nullptr) {
+        return MayWriteVariables(ternaryExpression->operand1)
+               || MayWriteVariables(ternaryExpression->operand2)
+               || MayWriteVariables(ternaryExpression->operand3);
+    }
+
+    auto retrievalExpression = dynamic_cast<const RetrievalExpression *>(expression);
+
+    if (retrievalExpression != nullptr) {
+        return MayWriteVariables(retrievalExpression->retrievee)
+               || MayWriteVariables(retrievalExpression->key);
+    }
+
+    auto invocationExpression = dynamic_cast<const InvocationExpression *>(expression);
+
+    if (invocationExpression != nullptr) {
+        if (MayWriteVariables(invocationExpression->invokee)) {
+            return true;
+        }
+
+        for (const Expression *argument : invocationExpression->arguments) {
+            if (MayWriteVariables(argument)) {
+                return true;
+            }
         }
     }
+
+    return false;
+}
+
+
+OpCode
+UnaryOperatorToOpCode(TokenType unaryOperator)
+{
+    switch (unaryOperator) {
+    case MakeTokenType('+'):
+        return OpCode::Positive;
+
+    case MakeTokenType('-'):
+        return OpCode::Negate;
+
+    case MakeTokenType('!'):
+        return OpCode::Not;
+
+    case MakeTokenType('~'):
+        return OpCode::BitwiseNot;
+
+    case TokenType::SizeofKeyword:
+        return OpCode::Sizeof;
+
+    case TokenType::BoolKeyword:
+        return OpCode::ToBoolean;
+
+    case TokenType::IntKeyword:
+        return OpCode::ToInteger;
+
+    case TokenType::FloatKeyword:
+        return OpCode::ToFloatingPoint;
+
+    case TokenType::StrKeyword:
+        return OpCode::ToString;
+
+    default:
+        return OpCode::No;
+    }
+}
+
+
+OpCode
+BinaryOperatorToOpCode(TokenType binaryOperator)
+{
+    switch (binaryOperator) {
+    case MakeTokenType('+'):
+    case MakeTokenType('+', '='):
+        return OpCode::Add;
+
+    case MakeTokenType('-'):
+    case MakeTokenType('-', '='):
+        return OpCode::Subtract;
+
+    case MakeTokenType('*'):
+    case MakeTokenType('*', '='):
+        return OpCode::Multiply;
+
+    case MakeTokenType('/'):
+    case MakeTokenType('/', '='):
+        return OpCode::Divide;
+
+    case MakeTokenType('%'):
+    case MakeTokenType('%', '='):
+        return OpCode::Modulo;
+
+    case MakeTokenType('<', '<'):
+    case MakeTokenType('<', '<', '='):
+        return OpCode::ShiftLeft;
+
+    case MakeTokenType('>', '>'):
+    case MakeTokenType('>', '>', '='):
+        return OpCode::ShiftRight;
+
+    case MakeTokenType('&'):
+    case MakeTokenType('&', '='):
+        return OpCode::BitwiseAnd;
+
+    case MakeTokenType('|'):
+    case MakeTokenType('|', '='):
+        return OpCode::BitwiseOr;
+
+    case MakeTokenType('^'):
+    case MakeTokenType('^', '='):
+        return OpCode::BitwiseXor;
+
+    case MakeTokenType('=', '='):
+        return OpCode::Equal;
+
+    case MakeTokenType('!', '='):
+        return OpCode::NotEqual;
+
+    case MakeTokenType('<'):
+        return OpCode::Less;
+
+    case MakeTokenType('<', '='):
+        return OpCode::LessEqual;
+
+    default:
+        return OpCode::No;
+    }
+}
+
+
+bool
+OpCodeSetsA(OpCode opCode)
+{
+    switch (opCode) {
+    case OpCode::Move:
+    case OpCode::LoadNull:
+    case OpCode::LoadBoolean:
+    case OpCode::LoadInteger:
+    case OpCode::LoadConstant:
+    case OpCode::LoadThis:
+    case OpCode::NewArray:
+    case OpCode::NewDictionary:
+    case OpCode::NewClosure:
+    case OpCode::NewCell:
+    case OpCode::GetElement:
+    case OpCode::GetField:
+    case OpCode::GetCell:
+    case OpCode::Positive:
+    case OpCode::Negate:
+    case OpCode::Not:
+    case OpCode::BitwiseNot:
+    case OpCode::Increment:
+    case OpCode::Decrement:
+    case OpCode::ToBoolean:
+    case OpCode::ToInteger:
+    case OpCode::ToFloatingPoint:
+    case OpCode::ToString:
+    case OpCode::Sizeof:
+    case OpCode::Add:
+    case OpCode::Subtract:
+    case OpCode::Multiply:
+    case OpCode::Divide:
+    case OpCode::Modulo:
+    case OpCode::ShiftLeft:
+    case OpCode::ShiftRight:
+    case OpCode::BitwiseAnd:
+    case OpCode::BitwiseOr:
+    case OpCode::BitwiseXor:
+    case OpCode::Equal:
+    case OpCode::NotEqual:
+    case OpCode::Less:
+    case OpCode::LessEqual:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+int
+GetSizeHint(std::size_t size)
+{
+    return static_cast<int>(std::min(size, static_cast<std::size_t>(MaxShortOperand)));
+}
+
+
+void
+ResolveSwitchTable(SwitchTable *switchTable, const std::vector<int> &caseLabels, int defaultLabel)
+{
+    for (int &target : switchTable->denseTargets) {
+        target = target < 0 ? defaultLabel : caseLabels[target];
+    }
+
+    for (std::pair<std::int64_t, int> &sparseTarget : switchTable->sparseTargets) {
+        sparseTarget.second = caseLabels[sparseTarget.second];
+    }
+
+    for (std::pair<const std::string, int> &stringTarget : switchTable->stringTargets) {
+        stringTarget.second = caseLabels[stringTarget.second];
+    }
+
+    switchTable->defaultTarget = defaultLabel;
+    return;
 }
 
+} // namespace
+
 } // namespace OYC
@@ -3,18 +3,27 @@
 
 #include <cstdint>
 
+#include "Arena.h"
 #include "ExpressionVisitor.h"
+#include "StatementVisitor.h"
+#include "StringInterner.h"
 
 
 namespace OYC {
 
 struct Program;
 struct Function;
+struct FunctionLiteral;
+struct ArrayLiteral;
+struct DictionaryLiteral;
+struct Expression;
+struct Statement;
+struct CaseClause;
 
 class CompilationContext;
 
 
-class Compiler final : public ExpressionVisitor
+class Compiler final : public ExpressionVisitor, public StatementVisitor
 {
     Compiler(const Compiler &) = delete;
     Compiler &operator=(const Compiler &) = delete;
@@ -25,7 +34,59 @@ public:
     Function generateFunction(const Program &);
 
 private:
+    const Program *program_;
+    const FunctionLiteral *functionLiteral_;
     CompilationContext *context_;
+    const Statement *statement_;
+
+    void generateFunction(const FunctionLiteral &, Function *);
+    void addVariable(SymbolID);
+    void generateStatements(const ArenaArray<Statement *> &);
+    void generateExpression(const Expression *);
+    void generateDiscardedExpression(const Expression *);
+    void generateArrayLiteral(const ArrayLiteral &);
+    void generateDictionaryLiteral(const DictionaryLiteral &);
+    void generateFunctionLiteral(const FunctionLiteral &);
+    void generateIncrement(const UnaryExpression &, bool);
+    void generateAssignment(const BinaryExpression &);
+    void generateLogicalExpression(const BinaryExpression &);
+    int generateRetrievalTarget(const RetrievalExpression &, const Expression *);
+    void popRetrievalTarget(int);
+    void emitGetElement(int, int, int, int);
+    void emitSetElement(int, int, int, int);
+    void emitMove(int, int);
+    void moveToNewRegister();
+    void isolateOperand(const Expression *);
+    int getFieldIndex(const Expression *);
+    int generateSwitchTable(const ArenaArray<CaseClause> &);
+
+    void visitPrimaryExpression(const PrimaryExpression &) override;
+    void visitUnaryExpression(const UnaryExpression &) override;
+    void visitBinaryExpression(const BinaryExpression &) override;
+    void visitTernaryExpression(const TernaryExpression &) override;
+    void visitRetrievalExpression(const RetrievalExpression &) override;
+    void visitInvocationExpression(const InvocationExpression &) override;
+
+    void visitExpressionStatement(const ExpressionStatement &) override;
+    void visitAutoStatement(const AutoStatement &) override;
+    void visitBreakStatement(const BreakStatement &) override;
+    void visitContinueStatement(const ContinueStatement &) override;
+    void visitReturnStatement(const ReturnStatement &) override;
+    void visitIfStatement(const IfStatement &) override;
+    void visitSwitchStatement(const SwitchStatement &) override;
+    void visitWhileStatement(const WhileStatement &) override;
+    void visitDoWhileStatement(const DoWhileStatement &) override;
+    void visitForStatement(const ForStatement &) override;
+    void visitForeachStatement(const ForeachStatement &) override;
 };
 
+
+Compiler::Compiler()
+  : program_(nullptr),
+    functionLiteral_(nullptr),
+    context_(nullptr),
+    statement_(nullptr)
+{
+}
+
 } // namespace OYC
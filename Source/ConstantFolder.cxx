@@ -0,0 +1,1017 @@
+#include "ConstantFolder.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "Expression.h"
+#include "Program.h"
+#include "Statement.h"
+#include "StringInterner.h"
+
+
+namespace OYC {
+
+namespace {
+
+PrimaryExpression *AsConstant(Expression *);
+const UnaryExpression *AsUnaryExpression(const Expression *, TokenType);
+bool IsLvalue(const Expression *);
+bool IsNumericExpression(const Expression *);
+bool IsInteger(Expression *, std::int64_t);
+bool IsNumber(const PrimaryExpression &);
+std::int64_t GetInteger(const PrimaryExpression &);
+double GetFloatingPoint(const PrimaryExpression &);
+
+} // namespace
+
+
+void
+ConstantFolder::foldProgram(Program *program)
+{
+    programData_ = &program->data;
+    foldStatements(program->main.body);
+
+    for (int i = 0; i < programData_->functionLiterals.getSize(); ++i) {
+        foldStatements(programData_->functionLiterals[i].body);
+    }
+
+    for (int i = 0; i < programData_->arrayLiterals.getSize(); ++i) {
+        for (Expression *&element : programData_->arrayLiterals[i].elements) {
+            foldExpression(&element);
+        }
+    }
+
+    for (int i = 0; i < programData_->dictionaryLiterals.getSize(); ++i) {
+        for (std::pair<Expression *, Expression *> &element
+             : programData_->dictionaryLiterals[i].elements) {
+            foldExpression(&element.first);
+            foldExpression(&element.second);
+        }
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::foldStatements(const ArenaArray<Statement *> &statements)
+{
+    for (Statement *statement : statements) {
+        foldStatement(statement);
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::foldStatement(Statement *statement)
+{
+    statement_ = statement;
+    statement->acceptVisit(this);
+    return;
+}
+
+
+void
+ConstantFolder::foldExpression(Expression **expression)
+{
+    expression_ = expression;
+    (*expression)->acceptVisit(this);
+    return;
+}
+
+
+void
+ConstantFolder::foldCondition(Expression **expression)
+{
+    foldExpression(expression);
+
+    for (;;) {
+        auto unaryExpression = dynamic_cast<const UnaryExpression *>(*expression);
+
+        if (unaryExpression == nullptr) {
+            return;
+        }
+
+        if (unaryExpression->op == TokenType::BoolKeyword) {
+            *expression = unaryExpression->operand;
+            continue;
+        }
+
+        if (unaryExpression->op != MakeTokenType('!')) {
+            return;
+        }
+
+        const UnaryExpression *operand = AsUnaryExpression(unaryExpression->operand
+                                                           , MakeTokenType('!'));
+
+        if (operand == nullptr) {
+            return;
+        }
+
+        *expression = operand->operand;
+    }
+}
+
+
+Expression *
+ConstantFolder::evaluateUnaryExpression(TokenType op, PrimaryExpression *operand)
+{
+    switch (op) {
+    case MakeTokenType('+'):
+        return IsNumber(*operand) ? operand : nullptr;
+
+    case MakeTokenType('-'):
+        if (operand->type == PrimaryExpressionType::Integer) {
+            return createInteger(0 - operand->integer);
+        }
+
+        if (operand->type == PrimaryExpressionType::FloatingPoint) {
+            return createFloatingPoint(-operand->floatingPoint);
+        }
+
+        return nullptr;
+
+    case MakeTokenType('~'):
+        if (operand->type == PrimaryExpressionType::Integer) {
+            return createInteger(~operand->integer);
+        }
+
+        return nullptr;
+
+    case MakeTokenType('!'):
+        return createBoolean(!constantToBoolean(*operand));
+
+    case TokenType::BoolKeyword:
+        return createBoolean(constantToBoolean(*operand));
+
+    case TokenType::IntKeyword:
+        switch (operand->type) {
+        case PrimaryExpressionType::Boolean:
+            return createInteger(operand->boolean);
+
+        case PrimaryExpressionType::Integer:
+            return operand;
+
+        case PrimaryExpressionType::FloatingPoint:
+            if (!(operand->floatingPoint >= -0x1p63 && operand->floatingPoint < 0x1p63)) {
+                return nullptr;
+            }
+
+            return createInteger(static_cast<std::int64_t>(operand->floatingPoint));
+
+        case PrimaryExpressionType::String: {
+                std::string_view string = programData_->strings.getString(operand->string);
+                std::int64_t integer;
+                std::from_chars_result result = std::from_chars(string.data()
+                                                                , string.data() + string.size()
+                                                                , integer);
+
+                if (result.ec != std::errc() || result.ptr != string.data() + string.size()) {
+                    return nullptr;
+                }
+
+                return createInteger(integer);
+            }
+
+        default:
+            return nullptr;
+        }
+
+    case TokenType::FloatKeyword:
+        switch (operand->type) {
+        case PrimaryExpressionType::Boolean:
+            return createFloatingPoint(operand->boolean);
+
+        case PrimaryExpressionType::Integer:
+            return createFloatingPoint(static_cast<double>(GetInteger(*operand)));
+
+        case PrimaryExpressionType::FloatingPoint:
+            return operand;
+
+        case PrimaryExpressionType::String: {
+                std::string string(programData_->strings.getString(operand->string));
+                char *end;
+                double floatingPoint = std::strtod(string.c_str(), &end);
+
+                if (string.empty() || end != string.c_str() + string.size()) {
+                    return nullptr;
+                }
+
+                return createFloatingPoint(floatingPoint);
+            }
+
+        default:
+            return nullptr;
+        }
+
+    case TokenType::StrKeyword: {
+            char buffer[32];
+            std::to_chars_result result;
+
+            switch (operand->type) {
+            case PrimaryExpressionType::Null:
+                return createString("null");
+
+            case PrimaryExpressionType::Boolean:
+                return createString(operand->boolean ? "true" : "false");
+
+            case PrimaryExpressionType::Integer:
+                result = std::to_chars(buffer, buffer + sizeof buffer, GetInteger(*operand));
+                break;
+
+            case PrimaryExpressionType::FloatingPoint:
+                result = std::to_chars(buffer, buffer + sizeof buffer, operand->floatingPoint);
+                break;
+
+            case PrimaryExpressionType::String:
+                return operand;
+
+            default:
+                return nullptr;
+            }
+
+            return createString(std::string_view(buffer, result.ptr - buffer));
+        }
+
+    case TokenType::SizeofKeyword:
+        if (operand->type == PrimaryExpressionType::String) {
+            return createInteger(programData_->strings.getString(operand->string).size());
+        }
+
+        return nullptr;
+
+    default:
+        return nullptr;
+    }
+}
+
+
+Expression *
+ConstantFolder::evaluateBinaryExpression(TokenType op, const PrimaryExpression &operand1
+                                         , const PrimaryExpression &operand2)
+{
+    switch (op) {
+    case MakeTokenType('=', '='):
+    case MakeTokenType('!', '='):
+    case MakeTokenType('<'):
+    case MakeTokenType('<', '='):
+    case MakeTokenType('>'):
+    case MakeTokenType('>', '='):
+        return evaluateComparison(op, operand1, operand2);
+
+    default:
+        break;
+    }
+
+    if (operand1.type == PrimaryExpressionType::Integer
+        && operand2.type == PrimaryExpressionType::Integer) {
+        std::int64_t integer1 = GetInteger(operand1);
+        std::int64_t integer2 = GetInteger(operand2);
+
+        switch (op) {
+        case MakeTokenType('+'):
+            return createInteger(operand1.integer + operand2.integer);
+
+        case MakeTokenType('-'):
+            return createInteger(operand1.integer - operand2.integer);
+
+        case MakeTokenType('*'):
+            return createInteger(operand1.integer * operand2.integer);
+
+        case MakeTokenType('/'):
+            if (integer2 == 0) {
+                return nullptr;
+            }
+
+            return createInteger(integer2 == -1 ? 0 - operand1.integer : integer1 / integer2);
+
+        case MakeTokenType('%'):
+            if (integer2 == 0) {
+                return nullptr;
+            }
+
+            return createInteger(integer2 == -1 ? 0 : integer1 % integer2);
+
+        case MakeTokenType('<', '<'):
+            return createInteger(operand1.integer << (integer2 & 63));
+
+        case MakeTokenType('>', '>'):
+            return createInteger(integer1 >> (integer2 & 63));
+
+        case MakeTokenType('&'):
+            return createInteger(operand1.integer & operand2.integer);
+
+        case MakeTokenType('|'):
+            return createInteger(operand1.integer | operand2.integer);
+
+        case MakeTokenType('^'):
+            return createInteger(operand1.integer ^ operand2.integer);
+
+        default:
+            return nullptr;
+        }
+    }
+
+    if (IsNumber(operand1) && IsNumber(operand2)) {
+        double floatingPoint1 = GetFloatingPoint(operand1);
+        double floatingPoint2 = GetFloatingPoint(operand2);
+
+        switch (op) {
+        case MakeTokenType('+'):
+            return createFloatingPoint(floatingPoint1 + floatingPoint2);
+
+        case MakeTokenType('-'):
+            return createFloatingPoint(floatingPoint1 - floatingPoint2);
+
+        case MakeTokenType('*'):
+            return createFloatingPoint(floatingPoint1 * floatingPoint2);
+
+        case MakeTokenType('/'):
+            return createFloatingPoint(floatingPoint1 / floatingPoint2);
+
+        case MakeTokenType('%'):
+            return createFloatingPoint(std::fmod(floatingPoint1, floatingPoint2));
+
+        default:
+            return nullptr;
+        }
+    }
+
+    if (op == MakeTokenType('+') && operand1.type == PrimaryExpressionType::String
+        && operand2.type == PrimaryExpressionType::String) {
+        std::string string(programData_->strings.getString(operand1.string));
+        string += programData_->strings.getString(operand2.string);
+        return createString(string);
+    }
+
+    return nullptr;
+}
+
+
+Expression *
+ConstantFolder::evaluateComparison(TokenType op, const PrimaryExpression &operand1
+                                   , const PrimaryExpression &operand2)
+{
+    if (op == MakeTokenType('=', '=') || op == MakeTokenType('!', '=')) {
+        bool isEqual;
+
+        if (IsNumber(operand1) && IsNumber(operand2)) {
+            if (operand1.type == PrimaryExpressionType::Integer
+                && operand2.type == PrimaryExpressionType::Integer) {
+                isEqual = operand1.integer == operand2.integer;
+            } else if (operand1.type == PrimaryExpressionType::FloatingPoint
+                       && operand2.type == PrimaryExpressionType::FloatingPoint) {
+                isEqual = operand1.floatingPoint == operand2.floatingPoint;
+            } else {
+                return nullptr;
+            }
+        } else if (operand1.type != operand2.type) {
+            isEqual = false;
+        } else {
+            switch (operand1.type) {
+            case PrimaryExpressionType::Null:
+                isEqual = true;
+                break;
+
+            case PrimaryExpressionType::Boolean:
+                isEqual = operand1.boolean == operand2.boolean;
+                break;
+
+            case PrimaryExpressionType::String:
+                isEqual = operand1.string == operand2.string;
+                break;
+
+            default:
+                return nullptr;
+            }
+        }
+
+        return createBoolean(isEqual == (op == MakeTokenType('=', '=')));
+    }
+
+    const PrimaryExpression *lhs = &operand1;
+    const PrimaryExpression *rhs = &operand2;
+
+    if (op == MakeTokenType('>') || op == MakeTokenType('>', '=')) {
+        std::swap(lhs, rhs);
+    }
+
+    bool orEqual = op == MakeTokenType('<', '=') || op == MakeTokenType('>', '=');
+    int result;
+
+    if (lhs->type == PrimaryExpressionType::Integer
+        && rhs->type == PrimaryExpressionType::Integer) {
+        std::int64_t integer1 = GetInteger(*lhs);
+        std::int64_t integer2 = GetInteger(*rhs);
+        result = integer1 < integer2 ? -1 : integer1 > integer2 ? 1 : 0;
+    } else if (IsNumber(*lhs) && IsNumber(*rhs)) {
+        double floatingPoint1 = GetFloatingPoint(*lhs);
+        double floatingPoint2 = GetFloatingPoint(*rhs);
+
+        if (floatingPoint1 < floatingPoint2) {
+            result = -1;
+        } else if (floatingPoint1 == floatingPoint2) {
+            result = 0;
+        } else {
+            return createBoolean(false);
+        }
+    } else if (lhs->type == PrimaryExpressionType::String
+               && rhs->type == PrimaryExpressionType::String) {
+        result = programData_->strings.getString(lhs->string)
+                 .compare(programData_->strings.getString(rhs->string));
+    } else {
+        return nullptr;
+    }
+
+    return createBoolean(orEqual ? result <= 0 : result < 0);
+}
+
+
+Expression *
+ConstantFolder::simplifyBinaryExpression(TokenType op, Expression *operand1
+                                         , Expression *operand2)
+{
+    Expression *operand = nullptr;
+
+    switch (op) {
+    case MakeTokenType('-'):
+        if (IsInteger(operand2, 0)) {
+            operand = operand1;
+        }
+
+        break;
+
+    case MakeTokenType('*'):
+        if (IsInteger(operand2, 1)) {
+            operand = operand1;
+        } else if (IsInteger(operand1, 1)) {
+            operand = operand2;
+        }
+
+        break;
+
+    case MakeTokenType('/'):
+        if (IsInteger(operand2, 1)) {
+            operand = operand1;
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    if (operand == nullptr) {
+        return nullptr;
+    }
+
+    return IsNumericExpression(operand) ? operand : createUnaryExpression(MakeTokenType('+')
+                                                                          , operand);
+}
+
+
+bool
+ConstantFolder::constantToBoolean(const PrimaryExpression &constant) const
+{
+    switch (constant.type) {
+    case PrimaryExpressionType::Boolean:
+        return constant.boolean;
+
+    case PrimaryExpressionType::Integer:
+        return constant.integer != 0;
+
+    case PrimaryExpressionType::FloatingPoint:
+        return constant.floatingPoint != 0.0;
+
+    case PrimaryExpressionType::String:
+        return !programData_->strings.getString(constant.string).empty();
+
+    default:
+        return false;
+    }
+}
+
+
+Expression *
+ConstantFolder::createBoolean(bool boolean)
+{
+    auto primaryExpression = programData_->arena.create<PrimaryExpression>();
+    primaryExpression->type = PrimaryExpressionType::Boolean;
+    primaryExpression->boolean = boolean;
+    return primaryExpression;
+}
+
+
+Expression *
+ConstantFolder::createInteger(unsigned long integer)
+{
+    auto primaryExpression = programData_->arena.create<PrimaryExpression>();
+    primaryExpression->type = PrimaryExpressionType::Integer;
+    primaryExpression->integer = integer;
+    return primaryExpression;
+}
+
+
+Expression *
+ConstantFolder::createFloatingPoint(double floatingPoint)
+{
+    auto primaryExpression = programData_->arena.create<PrimaryExpression>();
+    primaryExpression->type = PrimaryExpressionType::FloatingPoint;
+    primaryExpression->floatingPoint = floatingPoint;
+    return primaryExpression;
+}
+
+
+Expression *
+ConstantFolder::createString(std::string_view string)
+{
+    auto primaryExpression = programData_->arena.create<PrimaryExpression>();
+    primaryExpression->type = PrimaryExpressionType::String;
+    primaryExpression->string = programData_->strings.intern(string);
+    return primaryExpression;
+}
+
+
+Expression *
+ConstantFolder::createUnaryExpression(TokenType op, Expression *operand)
+{
+    auto unaryExpression = programData_->arena.create<UnaryExpression>();
+    unaryExpression->type = UnaryExpressionType::Prefix;
+    unaryExpression->op = op;
+    unaryExpression->operand = operand;
+    return unaryExpression;
+}
+
+
+void
+ConstantFolder::visitPrimaryExpression(const PrimaryExpression &)
+{
+    return;
+}
+
+
+void
+ConstantFolder::visitUnaryExpression(const UnaryExpression &)
+{
+    Expression **expression = expression_;
+    auto unaryExpression = static_cast<UnaryExpression *>(*expression);
+
+    switch (unaryExpression->op) {
+    case MakeTokenType('+', '+'):
+    case MakeTokenType('-', '-'):
+        if (IsLvalue(unaryExpression->operand)) {
+            foldExpression(&unaryExpression->operand);
+        }
+
+        return;
+
+    case MakeTokenType('!'):
+    case TokenType::BoolKeyword:
+        foldCondition(&unaryExpression->operand);
+        break;
+
+    default:
+        foldExpression(&unaryExpression->operand);
+        break;
+    }
+
+    PrimaryExpression *operand = AsConstant(unaryExpression->operand);
+
+    if (operand != nullptr) {
+        Expression *result = evaluateUnaryExpression(unaryExpression->op, operand);
+
+        if (result != nullptr) {
+            *expression = result;
+        }
+
+        return;
+    }
+
+    if (unaryExpression->op == MakeTokenType('!')) {
+        const UnaryExpression *operand2 = AsUnaryExpression(unaryExpression->operand
+                                                            , MakeTokenType('!'));
+
+        if (operand2 != nullptr) {
+            unaryExpression->op = TokenType::BoolKeyword;
+            unaryExpression->operand = operand2->operand;
+        }
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitBinaryExpression(const BinaryExpression &)
+{
+    Expression **expression = expression_;
+    auto binaryExpression = static_cast<BinaryExpression *>(*expression);
+
+    switch (binaryExpression->op) {
+    case MakeTokenType('='):
+    case MakeTokenType('|', '='):
+    case MakeTokenType('^', '='):
+    case MakeTokenType('&', '='):
+    case MakeTokenType('<', '<', '='):
+    case MakeTokenType('>', '>', '='):
+    case MakeTokenType('+', '='):
+    case MakeTokenType('-', '='):
+    case MakeTokenType('*', '='):
+    case MakeTokenType('/', '='):
+    case MakeTokenType('%', '='):
+        if (IsLvalue(binaryExpression->operand1)) {
+            foldExpression(&binaryExpression->operand1);
+        }
+
+        foldExpression(&binaryExpression->operand2);
+        return;
+
+    case MakeTokenType(','):
+        foldExpression(&binaryExpression->operand1);
+        foldExpression(&binaryExpression->operand2);
+
+        if (AsConstant(binaryExpression->operand1) != nullptr) {
+            *expression = binaryExpression->operand2;
+        }
+
+        return;
+
+    case MakeTokenType('&', '&'):
+    case MakeTokenType('|', '|'): {
+            foldCondition(&binaryExpression->operand1);
+            foldCondition(&binaryExpression->operand2);
+            PrimaryExpression *operand1 = AsConstant(binaryExpression->operand1);
+
+            if (operand1 == nullptr) {
+                return;
+            }
+
+            bool boolean = constantToBoolean(*operand1);
+
+            if (boolean == (binaryExpression->op == MakeTokenType('|', '|'))) {
+                *expression = createBoolean(boolean);
+                return;
+            }
+
+            PrimaryExpression *operand2 = AsConstant(binaryExpression->operand2);
+
+            if (operand2 == nullptr) {
+                *expression = createUnaryExpression(TokenType::BoolKeyword
+                                                    , binaryExpression->operand2);
+            } else {
+                *expression = createBoolean(constantToBoolean(*operand2));
+            }
+
+            return;
+        }
+
+    default: {
+            foldExpression(&binaryExpression->operand1);
+            foldExpression(&binaryExpression->operand2);
+            PrimaryExpression *operand1 = AsConstant(binaryExpression->operand1);
+            PrimaryExpression *operand2 = AsConstant(binaryExpression->operand2);
+            Expression *result = nullptr;
+
+            if (operand1 != nullptr && operand2 != nullptr) {
+                result = evaluateBinaryExpression(binaryExpression->op, *operand1, *operand2);
+            }
+
+            if (result == nullptr) {
+                result = simplifyBinaryExpression(binaryExpression->op, binaryExpression->operand1
+                                                  , binaryExpression->operand2);
+            }
+
+            if (result != nullptr) {
+                *expression = result;
+            }
+
+            return;
+        }
+    }
+}
+
+
+void
+ConstantFolder::visitTernaryExpression(const TernaryExpression &)
+{
+    Expression **expression = expression_;
+    auto ternaryExpression = static_cast<TernaryExpression *>(*expression);
+    foldCondition(&ternaryExpression->operand1);
+    foldExpression(&ternaryExpression->operand2);
+    foldExpression(&ternaryExpression->operand3);
+    PrimaryExpression *operand1 = AsConstant(ternaryExpression->operand1);
+
+    if (operand1 != nullptr) {
+        *expression = constantToBoolean(*operand1) ? ternaryExpression->operand2
+                                                   : ternaryExpression->operand3;
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitRetrievalExpression(const RetrievalExpression &)
+{
+    auto retrievalExpression = static_cast<RetrievalExpression *>(*expression_);
+    foldExpression(&retrievalExpression->retrievee);
+    foldExpression(&retrievalExpression->key);
+    return;
+}
+
+
+void
+ConstantFolder::visitInvocationExpression(const InvocationExpression &)
+{
+    auto invocationExpression = static_cast<InvocationExpression *>(*expression_);
+    Expression *invokee = invocationExpression->invokee;
+    foldExpression(&invocationExpression->invokee);
+
+    if (invocationExpression->invokee != invokee
+        && dynamic_cast<const RetrievalExpression *>(invocationExpression->invokee) != nullptr) {
+        invocationExpression->invokee = invokee;
+    }
+
+    for (Expression *&argument : invocationExpression->arguments) {
+        foldExpression(&argument);
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitExpressionStatement(const ExpressionStatement &)
+{
+    auto expressionStatement = static_cast<ExpressionStatement *>(statement_);
+    foldExpression(&expressionStatement->expression);
+    return;
+}
+
+
+void
+ConstantFolder::visitAutoStatement(const AutoStatement &)
+{
+    auto autoStatement = static_cast<AutoStatement *>(statement_);
+
+    for (VariableDeclarator &variableDeclarator : autoStatement->variableDeclarators) {
+        if (variableDeclarator.initializer != nullptr) {
+            foldExpression(&variableDeclarator.initializer);
+        }
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitBreakStatement(const BreakStatement &)
+{
+    return;
+}
+
+
+void
+ConstantFolder::visitContinueStatement(const ContinueStatement &)
+{
+    return;
+}
+
+
+void
+ConstantFolder::visitReturnStatement(const ReturnStatement &)
+{
+    auto returnStatement = static_cast<ReturnStatement *>(statement_);
+
+    if (returnStatement->result != nullptr) {
+        foldExpression(&returnStatement->result);
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitIfStatement(const IfStatement &)
+{
+    auto ifStatement = static_cast<IfStatement *>(statement_);
+    foldCondition(&ifStatement->condition);
+    foldStatements(ifStatement->thenBody);
+    foldStatements(ifStatement->elseBody);
+    return;
+}
+
+
+void
+ConstantFolder::visitSwitchStatement(const SwitchStatement &)
+{
+    auto switchStatement = static_cast<SwitchStatement *>(statement_);
+    foldExpression(&switchStatement->lhs);
+
+    for (CaseClause &caseClause : switchStatement->caseClauses) {
+        if (caseClause.rhs != nullptr) {
+            foldExpression(&caseClause.rhs);
+        }
+
+        foldStatements(caseClause.body);
+    }
+
+    return;
+}
+
+
+void
+ConstantFolder::visitWhileStatement(const WhileStatement &)
+{
+    auto whileStatement = static_cast<WhileStatement *>(statement_);
+    foldCondition(&whileStatement->condition);
+    foldStatements(whileStatement->body);
+    return;
+}
+
+
+void
+ConstantFolder::visitDoWhileStatement(const DoWhileStatement &)
+{
+    auto doWhileStatement = static_cast<DoWhileStatement *>(statement_);
+    foldStatements(doWhileStatement->body);
+    foldCondition(&doWhileStatement->condition);
+    return;
+}
+
+
+void
+ConstantFolder::visitForStatement(const ForStatement &)
+{
+    auto forStatement = static_cast<ForStatement *>(statement_);
+
+    if (forStatement->initialization != nullptr) {
+        foldStatement(forStatement->initialization);
+    }
+
+    if (forStatement->condition != nullptr) {
+        foldCondition(&forStatement->condition);
+    }
+
+    if (forStatement->iteration != nullptr) {
+        foldExpression(&forStatement->iteration);
+    }
+
+    foldStatements(forStatement->body);
+    return;
+}
+
+
+void
+ConstantFolder::visitForeachStatement(const ForeachStatement &)
+{
+    auto foreachStatement = static_cast<ForeachStatement *>(statement_);
+    foldExpression(&foreachStatement->collection);
+    foldStatements(foreachStatement->body);
+    return;
+}
+
+
+namespace {
+
+PrimaryExpression *
+AsConstant(Expression *expression)
+{
+    auto primaryExpression = dynamic_cast<PrimaryExpression *>(expression);
+
+    if (primaryExpression == nullptr) {
+        return nullptr;
+    }
+
+    switch (primaryExpression->type) {
+    case PrimaryExpressionType::Null:
+    case PrimaryExpressionType::Boolean:
+    case PrimaryExpressionType::Integer:
+    case PrimaryExpressionType::FloatingPoint:
+    case PrimaryExpressionType::String:
+        return primaryExpression;
+
+    default:
+        return nullptr;
+    }
+}
+
+
+const UnaryExpression *
+AsUnaryExpression(const Expression *expression, TokenType op)
+{
+    auto unaryExpression = dynamic_cast<const UnaryExpression *>(expression);
+
+    if (unaryExpression == nullptr || unaryExpression->op != op) {
+        return nullptr;
+    }
+
+    return unaryExpression;
+}
+
+
+bool
+IsLvalue(const Expression *expression)
+{
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(expression);
+
+    if (primaryExpression != nullptr) {
+        return primaryExpression->type == PrimaryExpressionType::VariableName;
+    }
+
+    return dynamic_cast<const RetrievalExpression *>(expression) != nullptr;
+}
+
+
+bool
+IsNumericExpression(const Expression *expression)
+{
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(expression);
+
+    if (primaryExpression != nullptr) {
+        return IsNumber(*primaryExpression);
+    }
+
+    auto unaryExpression = dynamic_cast<const UnaryExpression *>(expression);
+
+    if (unaryExpression != nullptr) {
+        switch (unaryExpression->op) {
+        case MakeTokenType('+', '+'):
+        case MakeTokenType('-', '-'):
+        case MakeTokenType('+'):
+        case MakeTokenType('-'):
+        case MakeTokenType('~'):
+        case TokenType::IntKeyword:
+        case TokenType::FloatKeyword:
+        case TokenType::SizeofKeyword:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    auto binaryExpression = dynamic_cast<const BinaryExpression *>(expression);
+
+    if (binaryExpression != nullptr) {
+        switch (binaryExpression->op) {
+        case MakeTokenType('-'):
+        case MakeTokenType('*'):
+        case MakeTokenType('/'):
+        case MakeTokenType('%'):
+        case MakeTokenType('<', '<'):
+        case MakeTokenType('>', '>'):
+        case MakeTokenType('&'):
+        case MakeTokenType('|'):
+        case MakeTokenType('^'):
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+bool
+IsInteger(Expression *expression, std::int64_t integer)
+{
+    PrimaryExpression *constant = AsConstant(expression);
+    return constant != nullptr && constant->type == PrimaryExpressionType::Integer
+           && GetInteger(*constant) == integer;
+}
+
+
+bool
+IsNumber(const PrimaryExpression &constant)
+{
+    return constant.type == PrimaryExpressionType::Integer
+           || constant.type == PrimaryExpressionType::FloatingPoint;
+}
+
+
+std::int64_t
+GetInteger(const PrimaryExpression &constant)
+{
+    return static_cast<std::int64_t>(constant.integer);
+}
+
+
+double
+GetFloatingPoint(const PrimaryExpression &constant)
+{
+    return constant.type == PrimaryExpressionType::Integer
+           ? static_cast<double>(GetInteger(constant)) : constant.floatingPoint;
+}
+
+} // namespace
+
+} // namespace OYC
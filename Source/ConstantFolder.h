@@ -0,0 +1,80 @@
+#pragma once
+
+
+#include <string_view>
+
+#include "Arena.h"
+#include "ExpressionVisitor.h"
+#include "StatementVisitor.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+struct Program;
+struct ProgramData;
+struct Expression;
+struct PrimaryExpression;
+struct Statement;
+
+
+class ConstantFolder final : public ExpressionVisitor, public StatementVisitor
+{
+    ConstantFolder(const ConstantFolder &) = delete;
+    ConstantFolder &operator=(const ConstantFolder &) = delete;
+
+public:
+    inline explicit ConstantFolder();
+
+    void foldProgram(Program *);
+
+private:
+    ProgramData *programData_;
+    Expression **expression_;
+    Statement *statement_;
+
+    void foldStatements(const ArenaArray<Statement *> &);
+    void foldStatement(Statement *);
+    void foldExpression(Expression **);
+    void foldCondition(Expression **);
+    Expression *evaluateUnaryExpression(TokenType, PrimaryExpression *);
+    Expression *evaluateBinaryExpression(TokenType, const PrimaryExpression &
+                                         , const PrimaryExpression &);
+    Expression *evaluateComparison(TokenType, const PrimaryExpression &, const PrimaryExpression &);
+    Expression *simplifyBinaryExpression(TokenType, Expression *, Expression *);
+    bool constantToBoolean(const PrimaryExpression &) const;
+    Expression *createBoolean(bool);
+    Expression *createInteger(unsigned long);
+    Expression *createFloatingPoint(double);
+    Expression *createString(std::string_view);
+    Expression *createUnaryExpression(TokenType, Expression *);
+
+    void visitPrimaryExpression(const PrimaryExpression &) override;
+    void visitUnaryExpression(const UnaryExpression &) override;
+    void visitBinaryExpression(const BinaryExpression &) override;
+    void visitTernaryExpression(const TernaryExpression &) override;
+    void visitRetrievalExpression(const RetrievalExpression &) override;
+    void visitInvocationExpression(const InvocationExpression &) override;
+
+    void visitExpressionStatement(const ExpressionStatement &) override;
+    void visitAutoStatement(const AutoStatement &) override;
+    void visitBreakStatement(const BreakStatement &) override;
+    void visitContinueStatement(const ContinueStatement &) override;
+    void visitReturnStatement(const ReturnStatement &) override;
+    void visitIfStatement(const IfStatement &) override;
+    void visitSwitchStatement(const SwitchStatement &) override;
+    void visitWhileStatement(const WhileStatement &) override;
+    void visitDoWhileStatement(const DoWhileStatement &) override;
+    void visitForStatement(const ForStatement &) override;
+    void visitForeachStatement(const ForeachStatement &) override;
+};
+
+
+ConstantFolder::ConstantFolder()
+  : programData_(nullptr),
+    expression_(nullptr),
+    statement_(nullptr)
+{
+}
+
+} // namespace OYC
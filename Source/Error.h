@@ -0,0 +1,213 @@
+#pragma once
+
+
+#include <stdexcept>
+#include <string>
+
+#include "Statement.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace Error {
+
+class TokenError : public std::runtime_error
+{
+public:
+    inline explicit TokenError(const Token &, const std::string &);
+
+    inline int getLineNumber() const noexcept;
+    inline int getColumnNumber() const noexcept;
+
+private:
+    int lineNumber_;
+    int columnNumber_;
+};
+
+
+class IllegalToken final : public TokenError
+{
+public:
+    inline explicit IllegalToken(const Token &);
+};
+
+
+class UnexpectedToken final : public TokenError
+{
+public:
+    inline explicit UnexpectedToken(const Token &, TokenType);
+    inline explicit UnexpectedToken(const Token &, TokenType, TokenType);
+    inline explicit UnexpectedToken(const Token &, const char *);
+};
+
+
+class DuplicateDefaultLabel final : public TokenError
+{
+public:
+    inline explicit DuplicateDefaultLabel(const Token &);
+};
+
+
+class UndeclaredVariable final : public TokenError
+{
+public:
+    inline explicit UndeclaredVariable(const Token &);
+};
+
+
+class StatementError : public std::runtime_error
+{
+public:
+    inline explicit StatementError(const Statement &, const std::string &);
+
+    inline int getLineNumber() const noexcept;
+    inline int getColumnNumber() const noexcept;
+
+private:
+    int lineNumber_;
+    int columnNumber_;
+};
+
+
+class NonLvalueExpression final : public StatementError
+{
+public:
+    inline explicit NonLvalueExpression(const Statement &);
+};
+
+
+class MisplacedStatement final : public StatementError
+{
+public:
+    inline explicit MisplacedStatement(const Statement &);
+};
+
+
+class RuntimeError final : public std::runtime_error
+{
+public:
+    inline explicit RuntimeError(const char *, int);
+
+    inline int getLineNumber() const noexcept;
+
+private:
+    int lineNumber_;
+};
+
+
+TokenError::TokenError(const Token &token, const std::string &message)
+  : std::runtime_error("line " + std::to_string(token.lineNumber) + ", column "
+                       + std::to_string(token.columnNumber) + ": " + message),
+    lineNumber_(token.lineNumber),
+    columnNumber_(token.columnNumber)
+{
+}
+
+
+int
+TokenError::getLineNumber() const noexcept
+{
+    return lineNumber_;
+}
+
+
+int
+TokenError::getColumnNumber() const noexcept
+{
+    return columnNumber_;
+}
+
+
+IllegalToken::IllegalToken(const Token &token)
+  : TokenError(token, "illegal token `" + std::string(token.value) + "'")
+{
+}
+
+
+UnexpectedToken::UnexpectedToken(const Token &token, TokenType expectedTokenType)
+  : TokenError(token, "unexpected token `" + std::string(token.value) + "', expected `"
+                      + TokenTypeToString(expectedTokenType) + "'")
+{
+}
+
+
+UnexpectedToken::UnexpectedToken(const Token &token, TokenType expectedTokenType1
+                                 , TokenType expectedTokenType2)
+  : TokenError(token, "unexpected token `" + std::string(token.value) + "', expected `"
+                      + TokenTypeToString(expectedTokenType1) + "' or `"
+                      + TokenTypeToString(expectedTokenType2) + "'")
+{
+}
+
+
+UnexpectedToken::UnexpectedToken(const Token &token, const char *expectedThing)
+  : TokenError(token, "unexpected token `" + std::string(token.value) + "', expected "
+                      + expectedThing)
+{
+}
+
+
+DuplicateDefaultLabel::DuplicateDefaultLabel(const Token &token)
+  : TokenError(token, "duplicate default label")
+{
+}
+
+
+UndeclaredVariable::UndeclaredVariable(const Token &token)
+  : TokenError(token, "undeclared variable `" + std::string(token.value) + "'")
+{
+}
+
+
+StatementError::StatementError(const Statement &statement, const std::string &message)
+  : std::runtime_error("line " + std::to_string(statement.lineNumber) + ", column "
+                       + std::to_string(statement.columnNumber) + ": " + message),
+    lineNumber_(statement.lineNumber),
+    columnNumber_(statement.columnNumber)
+{
+}
+
+
+int
+StatementError::getLineNumber() const noexcept
+{
+    return lineNumber_;
+}
+
+
+int
+StatementError::getColumnNumber() const noexcept
+{
+    return columnNumber_;
+}
+
+
+NonLvalueExpression::NonLvalueExpression(const Statement &statement)
+  : StatementError(statement, "assignment to a non-lvalue expression")
+{
+}
+
+
+MisplacedStatement::MisplacedStatement(const Statement &statement)
+  : StatementError(statement, "statement not within a loop or switch")
+{
+}
+
+
+RuntimeError::RuntimeError(const char *message, int lineNumber)
+  : std::runtime_error("line " + std::to_string(lineNumber) + ": " + message),
+    lineNumber_(lineNumber)
+{
+}
+
+
+int
+RuntimeError::getLineNumber() const noexcept
+{
+    return lineNumber_;
+}
+
+} // namespace Error
+
+} // namespace OYC
@@ -2,11 +2,9 @@
 
 
 #include <cstdint>
-#include <memory>
-#include <string>
-#include <utility>
-#include <vector>
 
+#include "Arena.h"
+#include "StringInterner.h"
 #include "Token.h"
 
 
@@ -52,7 +50,7 @@ struct PrimaryExpression : Expression
         bool boolean;
         unsigned long integer;
         double floatingPoint;
-        const std::string *string;
+        SymbolID string;
         const ArrayLiteral *arrayLiteral;
         const DictionaryLiteral *dictionaryLiteral;
         const FunctionLiteral *functionLiteral;
@@ -74,7 +72,7 @@ struct UnaryExpression : Expression
 {
     UnaryExpressionType type = UnaryExpressionType::No;
     TokenType op = TokenType::No;
-    std::unique_ptr<Expression> operand;
+    Expression *operand = nullptr;
 
     void acceptVisit(ExpressionVisitor *) const override;
 };
@@ -83,8 +81,8 @@ struct UnaryExpression : Expression
 struct BinaryExpression : Expression
 {
     TokenType op = TokenType::No;
-    std::unique_ptr<Expression> operand1;
-    std::unique_ptr<Expression> operand2;
+    Expression *operand1 = nullptr;
+    Expression *operand2 = nullptr;
 
     void acceptVisit(ExpressionVisitor *) const override;
 };
@@ -93,9 +91,9 @@ struct BinaryExpression : Expression
 struct TernaryExpression : Expression
 {
     TokenType op[2] = {TokenType::No, TokenType::No};
-    std::unique_ptr<Expression> operand1;
-    std::unique_ptr<Expression> operand2;
-    std::unique_ptr<Expression> operand3;
+    Expression *operand1 = nullptr;
+    Expression *operand2 = nullptr;
+    Expression *operand3 = nullptr;
 
     void acceptVisit(ExpressionVisitor *) const override;
 };
@@ -103,8 +101,8 @@ struct TernaryExpression : Expression
 
 struct RetrievalExpression : Expression
 {
-    std::unique_ptr<Expression> retrievee;
-    std::unique_ptr<Expression> key;
+    Expression *retrievee = nullptr;
+    Expression *key = nullptr;
 
     void acceptVisit(ExpressionVisitor *) const override;
 };
@@ -112,8 +110,8 @@ struct RetrievalExpression : Expression
 
 struct InvocationExpression : Expression
 {
-    std::unique_ptr<Expression> invokee;
-    std::vector<std::unique_ptr<Expression>> arguments;
+    Expression *invokee = nullptr;
+    ArenaArray<Expression *> arguments;
 
     void acceptVisit(ExpressionVisitor *) const override;
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Instruction.h"
+
+
+namespace OYC {
+
+enum class ConstantType : std::uint8_t
+{
+    No = 0,
+    Integer,
+    FloatingPoint,
+    String
+};
+
+
+struct Constant
+{
+    ConstantType type = ConstantType::No;
+
+    union {
+        std::int64_t integer;
+        double floatingPoint;
+    };
+
+    std::string string;
+};
+
+
+struct SwitchTable
+{
+    std::int64_t minInteger = 0;
+    std::vector<int> denseTargets;
+    std::vector<std::pair<std::int64_t, int>> sparseTargets;
+    std::unordered_map<std::string, int> stringTargets;
+    int defaultTarget = 0;
+};
+
+
+struct UpvalueDescriptor
+{
+    int superRegisterID = 0;
+};
+
+
+struct Function
+{
+    std::vector<Instruction> code;
+    std::vector<int> lineNumbers;
+    std::vector<Constant> constants;
+    std::vector<SwitchTable> switchTables;
+    std::vector<int> fieldKeyIndexes;
+    std::vector<UpvalueDescriptor> upvalueDescriptors;
+    std::vector<Function> functions;
+    int numberOfParameters = 0;
+    bool isVariadic = false;
+    int numberOfRegisters = 0;
+};
+
+} // namespace OYC
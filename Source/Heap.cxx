@@ -0,0 +1,177 @@
+#include "Heap.h"
+
+#include <algorithm>
+#include <new>
+
+
+namespace OYC {
+
+namespace {
+
+void DeleteObject(Object *);
+
+} // namespace
+
+
+Heap::~Heap()
+{
+    Object *object = firstObject_;
+
+    while (object != nullptr) {
+        Object *nextObject = object->next;
+        DeleteObject(object);
+        object = nextObject;
+    }
+}
+
+
+void
+Heap::markObject(Object *object)
+{
+    if (!object->isMarked) {
+        object->isMarked = true;
+        markStack_.push_back(object);
+    }
+
+    return;
+}
+
+
+void
+Heap::collectGarbage()
+{
+    while (!markStack_.empty()) {
+        Object *object = markStack_.back();
+        markStack_.pop_back();
+        markChildren(object);
+    }
+
+    sweep();
+    garbageCollectionThreshold_ = std::max(2 * numberOfObjects_, MinGarbageCollectionThreshold);
+    return;
+}
+
+
+void
+Heap::markChildren(Object *object)
+{
+    switch (object->type) {
+    case ObjectType::BoxedInteger:
+        return;
+
+    case ObjectType::String: {
+            auto string = static_cast<String *>(object);
+
+            if (string->ropeLeft != nullptr) {
+                markObject(string->ropeLeft);
+                markObject(string->ropeRight);
+            }
+
+            return;
+        }
+
+    case ObjectType::Array: {
+            auto array = static_cast<Array *>(object);
+
+            if (array->kind != ArrayKind::Generic) {
+                return;
+            }
+
+            for (Value element : array->elements) {
+                markValue(element);
+            }
+
+            return;
+        }
+
+    case ObjectType::Dictionary: {
+            auto dictionary = static_cast<Dictionary *>(object);
+
+            for (Value value : dictionary->values) {
+                markValue(value);
+            }
+
+            for (std::size_t i = 0; i < dictionary->elements.getNumberOfEntries(); ++i) {
+                const ValueMap::Entry &entry = dictionary->elements.getEntry(i);
+                markValue(entry.key);
+                markValue(entry.value);
+            }
+
+            return;
+        }
+
+    case ObjectType::Closure: {
+            auto closure = static_cast<Closure *>(object);
+            const Value *upvalues = closure->getUpvalues();
+
+            for (std::size_t i = 0; i < closure->numberOfUpvalues; ++i) {
+                markValue(upvalues[i]);
+            }
+
+            return;
+        }
+
+    case ObjectType::Cell:
+        markValue(static_cast<Cell *>(object)->value);
+        return;
+    }
+}
+
+
+void
+Heap::sweep()
+{
+    Object **object = &firstObject_;
+
+    while (*object != nullptr) {
+        if ((*object)->isMarked) {
+            (*object)->isMarked = false;
+            object = &(*object)->next;
+        } else {
+            Object *garbage = *object;
+            *object = garbage->next;
+            DeleteObject(garbage);
+            --numberOfObjects_;
+        }
+    }
+
+    return;
+}
+
+
+namespace {
+
+void
+DeleteObject(Object *object)
+{
+    switch (object->type) {
+    case ObjectType::BoxedInteger:
+        delete static_cast<BoxedInteger *>(object);
+        return;
+
+    case ObjectType::String:
+        delete static_cast<String *>(object);
+        return;
+
+    case ObjectType::Array:
+        delete static_cast<Array *>(object);
+        return;
+
+    case ObjectType::Dictionary:
+        delete static_cast<Dictionary *>(object);
+        return;
+
+    case ObjectType::Closure:
+        static_cast<Closure *>(object)->~Closure();
+        ::operator delete(object);
+        return;
+
+    case ObjectType::Cell:
+        delete static_cast<Cell *>(object);
+        return;
+    }
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,106 @@
+#pragma once
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Object.h"
+#include "Value.h"
+
+
+namespace OYC {
+
+class Heap final
+{
+    Heap(const Heap &) = delete;
+    Heap &operator=(const Heap &) = delete;
+
+public:
+    inline explicit Heap();
+    ~Heap();
+
+    template <class T>
+    inline T *createObject();
+
+    inline Closure *createClosure(std::size_t);
+
+    inline bool needsGarbageCollection() const noexcept;
+    inline void markValue(Value);
+    void markObject(Object *);
+    void collectGarbage();
+
+private:
+    static constexpr std::size_t MinGarbageCollectionThreshold = 1 << 16;
+
+    Object *firstObject_;
+    std::size_t numberOfObjects_;
+    std::size_t garbageCollectionThreshold_;
+    std::vector<Object *> markStack_;
+
+    template <class T>
+    inline void addObject(T *);
+
+    void markChildren(Object *);
+    void sweep();
+};
+
+
+Heap::Heap()
+  : firstObject_(nullptr),
+    numberOfObjects_(0),
+    garbageCollectionThreshold_(MinGarbageCollectionThreshold)
+{
+}
+
+
+template <class T>
+T *
+Heap::createObject()
+{
+    T *object = new T();
+    addObject(object);
+    return object;
+}
+
+
+Closure *
+Heap::createClosure(std::size_t numberOfUpvalues)
+{
+    void *memory = ::operator new(sizeof(Closure) + numberOfUpvalues * sizeof(Value));
+    auto closure = new (memory) Closure();
+    closure->numberOfUpvalues = numberOfUpvalues;
+    std::uninitialized_fill_n(closure->getUpvalues(), numberOfUpvalues, Value());
+    addObject(closure);
+    return closure;
+}
+
+
+bool
+Heap::needsGarbageCollection() const noexcept
+{
+    return numberOfObjects_ >= garbageCollectionThreshold_;
+}
+
+
+template <class T>
+void
+Heap::addObject(T *object)
+{
+    object->type = T::Type;
+    object->next = firstObject_;
+    firstObject_ = object;
+    ++numberOfObjects_;
+}
+
+
+void
+Heap::markValue(Value value)
+{
+    if (value.isObject()) {
+        markObject(value.getObject());
+    }
+}
+
+} // namespace OYC
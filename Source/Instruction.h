@@ -0,0 +1,120 @@
+#pragma once
+
+
+#include <cstdint>
+
+
+namespace OYC {
+
+enum class OpCode : std::uint8_t
+{
+    No = 0,
+
+    Move,
+    LoadNull,
+    LoadBoolean,
+    LoadInteger,
+    LoadConstant,
+    LoadThis,
+
+    NewArray,
+    NewDictionary,
+    NewClosure,
+    NewCell,
+    ArrayPush,
+    ArrayPushVarargs,
+    GetElement,
+    SetElement,
+    GetField,
+    SetField,
+    GetCell,
+    SetCell,
+
+    Positive,
+    Negate,
+    Not,
+    BitwiseNot,
+    Increment,
+    Decrement,
+    ToBoolean,
+    ToInteger,
+    ToFloatingPoint,
+    ToString,
+    Sizeof,
+
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    ShiftLeft,
+    ShiftRight,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+
+    Jump,
+    JumpIfTrue,
+    JumpIfFalse,
+    Switch,
+    ForeachNext,
+    Call,
+    CallWithArray,
+    Return,
+    ReturnNull
+};
+
+
+struct Instruction
+{
+    OpCode opCode = OpCode::No;
+    std::uint16_t a = 0;
+    std::uint16_t b = 0;
+    std::uint16_t c = 0;
+};
+
+static_assert(sizeof(Instruction) == 8);
+
+
+constexpr Instruction MakeInstruction(OpCode, int = 0, int = 0, int = 0);
+constexpr Instruction MakeWideInstruction(OpCode, int, std::int32_t);
+constexpr std::int32_t GetWideOperand(const Instruction &);
+constexpr void SetWideOperand(Instruction *, std::int32_t);
+
+
+constexpr Instruction
+MakeInstruction(OpCode opCode, int a, int b, int c)
+{
+    return Instruction{opCode, static_cast<std::uint16_t>(a), static_cast<std::uint16_t>(b)
+                       , static_cast<std::uint16_t>(c)};
+}
+
+
+constexpr Instruction
+MakeWideInstruction(OpCode opCode, int a, std::int32_t bc)
+{
+    Instruction instruction = MakeInstruction(opCode, a);
+    SetWideOperand(&instruction, bc);
+    return instruction;
+}
+
+
+constexpr std::int32_t
+GetWideOperand(const Instruction &instruction)
+{
+    return static_cast<std::int32_t>(instruction.b | static_cast<std::uint32_t>(instruction.c) << 16);
+}
+
+
+constexpr void
+SetWideOperand(Instruction *instruction, std::int32_t bc)
+{
+    instruction->b = static_cast<std::uint16_t>(bc);
+    instruction->c = static_cast<std::uint16_t>(static_cast<std::uint32_t>(bc) >> 16);
+}
+
+} // namespace OYC
@@ -0,0 +1,1583 @@
+#include "Interpreter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+#include "Error.h"
+#include "Function.h"
+#include "Instruction.h"
+#include "Object.h"
+#include "ScopeGuard.h"
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(OYC_NO_COMPUTED_GOTO)
+#   define OYC_COMPUTED_GOTO
+#endif
+
+
+namespace OYC {
+
+struct InlineCache
+{
+    static constexpr int MaxNumberOfEntries = 4;
+
+    struct Entry
+    {
+        const Shape *shape = nullptr;
+        Shape *newShape = nullptr;
+        int index = 0;
+    };
+
+    Value key;
+    int numberOfEntries = 0;
+    Entry entries[MaxNumberOfEntries];
+};
+
+
+struct Prototype
+{
+    const Function *function = nullptr;
+    std::vector<Value> constants;
+    mutable std::vector<InlineCache> inlineCaches;
+    std::vector<Prototype> prototypes;
+};
+
+
+struct Interpreter::Frame
+{
+    const Prototype *prototype;
+    const Instruction *returnAddress;
+    std::size_t registerBase;
+    Value thisValue;
+    Array *varargs;
+};
+
+
+namespace {
+
+constexpr std::size_t MaxNumberOfRegisters = std::size_t(1) << 22;
+constexpr int MaxNumberOfShapedKeys = 32;
+constexpr std::size_t MinRopeLength = 64;
+
+
+void BuildPrototype(Heap *, const Function &, Prototype *);
+void MarkPrototype(Heap *, const Prototype &);
+Value MakeInteger(Heap *, std::int64_t);
+bool ValueToBoolean(Value) noexcept;
+bool AreSmallIntegers(Value, Value) noexcept;
+bool AreIntegers(Value, Value) noexcept;
+bool AreNumbers(Value, Value) noexcept;
+double ValueToFloatingPoint(Value) noexcept;
+std::int64_t AddIntegers(std::int64_t, std::int64_t) noexcept;
+std::int64_t SubtractIntegers(std::int64_t, std::int64_t) noexcept;
+std::int64_t MultiplyIntegers(std::int64_t, std::int64_t) noexcept;
+std::int64_t ShiftIntegerLeft(std::int64_t, std::int64_t) noexcept;
+bool GetArrayIndex(Value, std::size_t, std::size_t *) noexcept;
+int LookUpSwitchTable(const SwitchTable &, Value);
+int LookUpIntegerCase(const SwitchTable &, std::int64_t) noexcept;
+void ConvertToHashTable(Dictionary *);
+const InlineCache::Entry *ProbeInlineCache(const InlineCache &, const Shape *) noexcept;
+void UpdateInlineCache(InlineCache *, const InlineCache::Entry &) noexcept;
+
+} // namespace
+
+
+Interpreter::Interpreter()
+  : prototype_(nullptr),
+    numberOfExecutedInstructions_(0),
+    numberOfInlineCacheHits_(0),
+    numberOfInlineCacheMisses_(0)
+{
+}
+
+
+Interpreter::~Interpreter()
+{
+}
+
+
+Value
+Interpreter::createString(std::string_view stringValue)
+{
+    auto string = heap_.createObject<String>();
+    string->value = stringValue;
+    return Value::MakeObject(ValueType::String, string);
+}
+
+
+Value
+Interpreter::execute(const Function &function, const std::vector<Value> &arguments)
+{
+    Prototype prototype;
+    BuildPrototype(&heap_, function, &prototype);
+    auto closure = heap_.createClosure(0);
+    closure->prototype = &prototype;
+    prototype_ = &prototype;
+
+    ScopeGuard scopeGuard([this] () -> void {
+        frames_.clear();
+        prototype_ = nullptr;
+    });
+
+    scopeGuard.commit();
+    auto numberOfArguments = static_cast<int>(std::min(arguments.size(), MaxNumberOfRegisters));
+    registers_.resize(std::max(registers_.size(), numberOfArguments + std::size_t(2)));
+    registers_[0] = Value::MakeObject(ValueType::Closure, closure);
+    registers_[1] = Value();
+    std::copy_n(arguments.begin(), numberOfArguments, registers_.begin() + 2);
+    enterFunction(closure, 2, numberOfArguments, Value(), nullptr);
+    return run();
+}
+
+
+std::uint64_t
+Interpreter::getNumberOfExecutedInstructions() const
+{
+    return numberOfExecutedInstructions_;
+}
+
+
+std::uint64_t
+Interpreter::getNumberOfInlineCacheHits() const
+{
+    return numberOfInlineCacheHits_;
+}
+
+
+std::uint64_t
+Interpreter::getNumberOfInlineCacheMisses() const
+{
+    return numberOfInlineCacheMisses_;
+}
+
+
+Value
+Interpreter::run()
+{
+#if defined(OYC_COMPUTED_GOTO)
+    static const void *const Labels[] = {
+        &&LabelNo,
+        &&LabelMove,
+        &&LabelLoadNull,
+        &&LabelLoadBoolean,
+        &&LabelLoadInteger,
+        &&LabelLoadConstant,
+        &&LabelLoadThis,
+        &&LabelNewArray,
+        &&LabelNewDictionary,
+        &&LabelNewClosure,
+        &&LabelNewCell,
+        &&LabelArrayPush,
+        &&LabelArrayPushVarargs,
+        &&LabelGetElement,
+        &&LabelSetElement,
+        &&LabelGetField,
+        &&LabelSetField,
+        &&LabelGetCell,
+        &&LabelSetCell,
+        &&LabelPositive,
+        &&LabelNegate,
+        &&LabelNot,
+        &&LabelBitwiseNot,
+        &&LabelIncrement,
+        &&LabelDecrement,
+        &&LabelToBoolean,
+        &&LabelToInteger,
+        &&LabelToFloatingPoint,
+        &&LabelToString,
+        &&LabelSizeof,
+        &&LabelAdd,
+        &&LabelSubtract,
+        &&LabelMultiply,
+        &&LabelDivide,
+        &&LabelModulo,
+        &&LabelShiftLeft,
+        &&LabelShiftRight,
+        &&LabelBitwiseAnd,
+        &&LabelBitwiseOr,
+        &&LabelBitwiseXor,
+        &&LabelEqual,
+        &&LabelNotEqual,
+        &&LabelLess,
+        &&LabelLessEqual,
+        &&LabelJump,
+        &&LabelJumpIfTrue,
+        &&LabelJumpIfFalse,
+        &&LabelSwitch,
+        &&LabelForeachNext,
+        &&LabelCall,
+        &&LabelCallWithArray,
+        &&LabelReturn,
+        &&LabelReturnNull
+    };
+
+    static_assert(std::size(Labels) == static_cast<std::size_t>(OpCode::ReturnNull) + 1);
+#   define VM_CASE(opCode) \
+        Label##opCode
+#   define VM_DISPATCH() \
+        instruction = pc++;                                             \
+        VM_COUNT_INSTRUCTION();                                         \
+        goto *Labels[static_cast<std::size_t>(instruction->opCode)]
+#else
+#   define VM_CASE(opCode) \
+        case OpCode::opCode
+#   define VM_DISPATCH() \
+        continue
+#endif
+#if defined(OYC_COUNT_INSTRUCTIONS)
+#   define VM_COUNT_INSTRUCTION() \
+        ++numberOfExecutedInstructions_
+#else
+#   define VM_COUNT_INSTRUCTION() \
+        static_cast<void>(0)
+#endif
+#define VM_RELOAD_FRAME() \
+    do {                                                                \
+        const Frame &frame = frames_.back();                            \
+        code = frame.prototype->function->code.data();                  \
+        constants = frame.prototype->constants.data();                  \
+        inlineCaches = frame.prototype->inlineCaches.data();            \
+        r = &registers_[frame.registerBase];                            \
+    } while (false)
+
+    const Instruction *code;
+    const Value *constants;
+    InlineCache *inlineCaches;
+    Value *r;
+    VM_RELOAD_FRAME();
+    const Instruction *pc = code;
+    const Instruction *instruction;
+
+#if defined(OYC_COMPUTED_GOTO)
+    VM_DISPATCH();
+#else
+    for (;;) {
+        instruction = pc++;
+        VM_COUNT_INSTRUCTION();
+
+        switch (instruction->opCode) {
+#endif
+    VM_CASE(No):
+        raiseError(instruction, "invalid instruction");
+
+    VM_CASE(Move):
+        r[instruction->a] = r[instruction->b];
+        VM_DISPATCH();
+
+    VM_CASE(LoadNull):
+        r[instruction->a] = Value();
+        VM_DISPATCH();
+
+    VM_CASE(LoadBoolean):
+        r[instruction->a] = Value::MakeBoolean(instruction->b != 0);
+        VM_DISPATCH();
+
+    VM_CASE(LoadInteger):
+        r[instruction->a] = Value::MakeSmallInteger(GetWideOperand(*instruction));
+        VM_DISPATCH();
+
+    VM_CASE(LoadConstant):
+        r[instruction->a] = constants[GetWideOperand(*instruction)];
+        VM_DISPATCH();
+
+    VM_CASE(LoadThis):
+        r[instruction->a] = frames_.back().thisValue;
+        VM_DISPATCH();
+
+    VM_CASE(NewArray):
+        {
+            collectGarbageIfNeeded();
+            auto array = heap_.createObject<Array>();
+            array->elements.reserve(instruction->b);
+            r[instruction->a] = Value::MakeObject(ValueType::Array, array);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(NewDictionary):
+        {
+            collectGarbageIfNeeded();
+            auto dictionary = heap_.createObject<Dictionary>();
+            dictionary->shape = &rootShape_;
+            dictionary->values.reserve(instruction->b);
+            r[instruction->a] = Value::MakeObject(ValueType::Dictionary, dictionary);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(NewClosure):
+        {
+            collectGarbageIfNeeded();
+            const Prototype &prototype = frames_.back().prototype
+                                         ->prototypes[GetWideOperand(*instruction)];
+            const std::vector<UpvalueDescriptor> &upvalueDescriptors
+                = prototype.function->upvalueDescriptors;
+            auto closure = heap_.createClosure(upvalueDescriptors.size());
+            closure->prototype = &prototype;
+            Value *upvalues = closure->getUpvalues();
+
+            for (std::size_t i = 0; i < upvalueDescriptors.size(); ++i) {
+                upvalues[i] = r[upvalueDescriptors[i].superRegisterID];
+            }
+
+            r[instruction->a] = Value::MakeObject(ValueType::Closure, closure);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(NewCell):
+        {
+            collectGarbageIfNeeded();
+            auto cell = heap_.createObject<Cell>();
+            cell->value = r[instruction->b];
+            r[instruction->a] = Value::MakeCell(cell);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(ArrayPush):
+        {
+            Array *array = r[instruction->a].getArray();
+            array->setElement(array->elements.size(), r[instruction->b]);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(ArrayPushVarargs):
+        {
+            const Array *varargs = frames_.back().varargs;
+
+            if (varargs != nullptr) {
+                Array *array = r[instruction->a].getArray();
+                array->elements.reserve(array->elements.size() + varargs->elements.size());
+
+                for (Value element : varargs->elements) {
+                    array->setElement(array->elements.size(), element);
+                }
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(GetElement):
+        r[instruction->a] = getElement(instruction, r[instruction->b], r[instruction->c]);
+        VM_DISPATCH();
+
+    VM_CASE(SetElement):
+        setElement(instruction, r[instruction->a], r[instruction->b], r[instruction->c]);
+        VM_DISPATCH();
+
+    VM_CASE(GetField):
+        {
+            InlineCache *inlineCache = &inlineCaches[instruction->c];
+            Value object = r[instruction->b];
+
+            if (!getField(inlineCache, object, &r[instruction->a])) {
+                r[instruction->a] = getElement(instruction, object, inlineCache->key);
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(SetField):
+        {
+            InlineCache *inlineCache = &inlineCaches[instruction->b];
+            Value object = r[instruction->a];
+            Value value = r[instruction->c];
+
+            if (!setField(inlineCache, object, value)) {
+                setElement(instruction, object, inlineCache->key, value);
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(GetCell):
+        r[instruction->a] = r[instruction->b].getCell()->value;
+        VM_DISPATCH();
+
+    VM_CASE(SetCell):
+        r[instruction->a].getCell()->value = r[instruction->b];
+        VM_DISPATCH();
+
+    VM_CASE(Positive):
+    VM_CASE(Negate):
+    VM_CASE(BitwiseNot):
+    VM_CASE(Increment):
+    VM_CASE(Decrement):
+    VM_CASE(ToInteger):
+    VM_CASE(ToFloatingPoint):
+    VM_CASE(ToString):
+    VM_CASE(Sizeof):
+        r[instruction->a] = convertValue(instruction, r[instruction->b]);
+        VM_DISPATCH();
+
+    VM_CASE(Not):
+        r[instruction->a] = Value::MakeBoolean(!ValueToBoolean(r[instruction->b]));
+        VM_DISPATCH();
+
+    VM_CASE(ToBoolean):
+        r[instruction->a] = Value::MakeBoolean(ValueToBoolean(r[instruction->b]));
+        VM_DISPATCH();
+
+    VM_CASE(Add):
+        {
+            Value value1 = r[instruction->b];
+            Value value2 = r[instruction->c];
+
+            if (AreSmallIntegers(value1, value2)) {
+                std::int64_t integer = AddIntegers(value1.getSmallInteger()
+                                                  , value2.getSmallInteger());
+                r[instruction->a] = MakeInteger(&heap_, integer);
+            } else {
+                r[instruction->a] = performArithmetic(instruction, value1, value2);
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Subtract):
+        {
+            Value value1 = r[instruction->b];
+            Value value2 = r[instruction->c];
+
+            if (AreSmallIntegers(value1, value2)) {
+                std::int64_t integer = SubtractIntegers(value1.getSmallInteger()
+                                                       , value2.getSmallInteger());
+                r[instruction->a] = MakeInteger(&heap_, integer);
+            } else {
+                r[instruction->a] = performArithmetic(instruction, value1, value2);
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Multiply):
+    VM_CASE(Divide):
+    VM_CASE(Modulo):
+    VM_CASE(ShiftLeft):
+    VM_CASE(ShiftRight):
+    VM_CASE(BitwiseAnd):
+    VM_CASE(BitwiseOr):
+    VM_CASE(BitwiseXor):
+        r[instruction->a] = performArithmetic(instruction, r[instruction->b], r[instruction->c]);
+        VM_DISPATCH();
+
+    VM_CASE(Equal):
+        r[instruction->a] = Value::MakeBoolean(ValuesAreEqual(r[instruction->b]
+                                                              , r[instruction->c]));
+        VM_DISPATCH();
+
+    VM_CASE(NotEqual):
+        r[instruction->a] = Value::MakeBoolean(!ValuesAreEqual(r[instruction->b]
+                                                               , r[instruction->c]));
+        VM_DISPATCH();
+
+    VM_CASE(Less):
+        {
+            Value value1 = r[instruction->b];
+            Value value2 = r[instruction->c];
+            bool result;
+
+            if (AreSmallIntegers(value1, value2)) {
+                result = value1.getSmallInteger() < value2.getSmallInteger();
+            } else {
+                result = compareValues(instruction, value1, value2);
+            }
+
+            r[instruction->a] = Value::MakeBoolean(result);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(LessEqual):
+        {
+            Value value1 = r[instruction->b];
+            Value value2 = r[instruction->c];
+            bool result;
+
+            if (AreSmallIntegers(value1, value2)) {
+                result = value1.getSmallInteger() <= value2.getSmallInteger();
+            } else {
+                result = compareValues(instruction, value1, value2);
+            }
+
+            r[instruction->a] = Value::MakeBoolean(result);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Jump):
+        pc = code + GetWideOperand(*instruction);
+
+        if (pc <= instruction) {
+            collectGarbageIfNeeded();
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(JumpIfTrue):
+        if (ValueToBoolean(r[instruction->a])) {
+            pc = code + GetWideOperand(*instruction);
+
+            if (pc <= instruction) {
+                collectGarbageIfNeeded();
+            }
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(JumpIfFalse):
+        if (!ValueToBoolean(r[instruction->a])) {
+            pc = code + GetWideOperand(*instruction);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Switch):
+        {
+            const Function &function = *frames_.back().prototype->function;
+            const SwitchTable &switchTable = function.switchTables[GetWideOperand(*instruction)];
+            pc = code + LookUpSwitchTable(switchTable, r[instruction->a]);
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(ForeachNext):
+        if (advanceIterator(instruction, &r[instruction->a])) {
+            pc = code + GetWideOperand(*instruction);
+            collectGarbageIfNeeded();
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Call):
+        {
+            Value callee = r[instruction->a];
+
+            if (callee.getType() != ValueType::Closure) {
+                raiseError(instruction, "value is not callable");
+            }
+
+            Value thisValue = instruction->c == 0 ? Value() : r[instruction->a + 1];
+            std::size_t registerBase = frames_.back().registerBase + instruction->a + 2;
+            enterFunction(callee.getClosure(), registerBase, instruction->b, thisValue
+                          , instruction);
+            VM_RELOAD_FRAME();
+            pc = code;
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(CallWithArray):
+        {
+            Value callee = r[instruction->a];
+
+            if (callee.getType() != ValueType::Closure) {
+                raiseError(instruction, "value is not callable");
+            }
+
+            Value thisValue = instruction->c == 0 ? Value() : r[instruction->a + 1];
+            std::size_t registerBase = frames_.back().registerBase + instruction->a + 2;
+            const std::vector<Value> &arguments = r[instruction->a + 2].getArray()->elements;
+
+            if (arguments.size() > MaxNumberOfRegisters - registerBase) {
+                raiseError(instruction, "stack overflow");
+            }
+
+            auto numberOfArguments = static_cast<int>(arguments.size());
+            registers_.resize(std::max(registers_.size(), registerBase + arguments.size()));
+            std::copy(arguments.begin(), arguments.end(), registers_.begin() + registerBase);
+            enterFunction(callee.getClosure(), registerBase, numberOfArguments, thisValue
+                          , instruction);
+            VM_RELOAD_FRAME();
+            pc = code;
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(Return):
+        {
+            Value result = r[instruction->a];
+            const Frame &frame = frames_.back();
+            const Instruction *returnAddress = frame.returnAddress;
+            registers_[frame.registerBase - 2] = result;
+            frames_.pop_back();
+
+            if (returnAddress == nullptr) {
+                return result;
+            }
+
+            VM_RELOAD_FRAME();
+            pc = returnAddress;
+        }
+
+        VM_DISPATCH();
+
+    VM_CASE(ReturnNull):
+        {
+            const Frame &frame = frames_.back();
+            const Instruction *returnAddress = frame.returnAddress;
+            registers_[frame.registerBase - 2] = Value();
+            frames_.pop_back();
+
+            if (returnAddress == nullptr) {
+                return Value();
+            }
+
+            VM_RELOAD_FRAME();
+            pc = returnAddress;
+        }
+
+        VM_DISPATCH();
+#if !defined(OYC_COMPUTED_GOTO)
+        }
+    }
+#endif
+
+#undef VM_CASE
+#undef VM_DISPATCH
+#undef VM_COUNT_INSTRUCTION
+#undef VM_RELOAD_FRAME
+}
+
+
+void
+Interpreter::enterFunction(const Closure *closure, std::size_t registerBase
+                           , int numberOfArguments, Value thisValue
+                           , const Instruction *instruction)
+{
+    const Function &function = *closure->prototype->function;
+
+    if (static_cast<std::size_t>(function.numberOfRegisters) > MaxNumberOfRegisters
+                                                                 - registerBase) {
+        raiseError(instruction, "stack overflow");
+    }
+
+    registers_.resize(std::max(registers_.size(), registerBase + function.numberOfRegisters));
+    Value *r = &registers_[registerBase];
+    Array *varargs = nullptr;
+
+    if (function.isVariadic) {
+        varargs = createVarargs(r, function.numberOfParameters, numberOfArguments);
+    }
+
+    std::fill(r + std::min(numberOfArguments, function.numberOfParameters)
+              , r + function.numberOfParameters, Value());
+    r = std::copy_n(closure->getUpvalues(), closure->numberOfUpvalues
+                    , r + function.numberOfParameters);
+    std::fill(r, &registers_[registerBase] + function.numberOfRegisters, Value());
+    const Instruction *returnAddress = instruction == nullptr ? nullptr : instruction + 1;
+    frames_.push_back({closure->prototype, returnAddress, registerBase, thisValue, varargs});
+    collectGarbageIfNeeded();
+    return;
+}
+
+
+Array *
+Interpreter::createVarargs(const Value *arguments, int numberOfParameters
+                           , int numberOfArguments)
+{
+    auto varargs = heap_.createObject<Array>();
+    varargs->kind = ArrayKind::Generic;
+
+    if (numberOfArguments > numberOfParameters) {
+        varargs->elements.assign(arguments + numberOfParameters, arguments + numberOfArguments);
+    }
+
+    return varargs;
+}
+
+
+void
+Interpreter::collectGarbageIfNeeded()
+{
+    if (!heap_.needsGarbageCollection()) {
+        return;
+    }
+
+    std::size_t numberOfRegisters = 0;
+
+    for (const Frame &frame : frames_) {
+        std::size_t registerTop = frame.registerBase + frame.prototype->function->numberOfRegisters;
+        numberOfRegisters = std::max(numberOfRegisters, registerTop);
+        heap_.markValue(frame.thisValue);
+
+        if (frame.varargs != nullptr) {
+            heap_.markObject(frame.varargs);
+        }
+    }
+
+    for (std::size_t i = 0; i < numberOfRegisters; ++i) {
+        heap_.markValue(registers_[i]);
+    }
+
+    if (prototype_ != nullptr) {
+        MarkPrototype(&heap_, *prototype_);
+    }
+
+    heap_.collectGarbage();
+    return;
+}
+
+
+void
+Interpreter::raiseError(const Instruction *instruction, const char *message) const
+{
+    int lineNumber = 0;
+
+    if (instruction != nullptr) {
+        const Function &function = *frames_.back().prototype->function;
+        lineNumber = function.lineNumbers[instruction - function.code.data()];
+    }
+
+    throw Error::RuntimeError(message, lineNumber);
+}
+
+
+Value
+Interpreter::performArithmetic(const Instruction *instruction, Value value1, Value value2)
+{
+    if (AreIntegers(value1, value2)) {
+        std::int64_t integer1 = value1.getInteger();
+        std::int64_t integer2 = value2.getInteger();
+
+        switch (instruction->opCode) {
+        case OpCode::Add:
+            return MakeInteger(&heap_, AddIntegers(integer1, integer2));
+
+        case OpCode::Subtract:
+            return MakeInteger(&heap_, SubtractIntegers(integer1, integer2));
+
+        case OpCode::Multiply:
+            return MakeInteger(&heap_, MultiplyIntegers(integer1, integer2));
+
+        case OpCode::Divide:
+            if (integer2 == 0) {
+                raiseError(instruction, "division by zero");
+            }
+
+            return MakeInteger(&heap_, integer2 == -1 ? SubtractIntegers(0, integer1)
+                                                     : integer1 / integer2);
+
+        case OpCode::Modulo:
+            if (integer2 == 0) {
+                raiseError(instruction, "division by zero");
+            }
+
+            return MakeInteger(&heap_, integer2 == -1 ? 0 : integer1 % integer2);
+
+        case OpCode::ShiftLeft:
+            return MakeInteger(&heap_, ShiftIntegerLeft(integer1, integer2));
+
+        case OpCode::ShiftRight:
+            return MakeInteger(&heap_, integer1 >> (integer2 & 63));
+
+        case OpCode::BitwiseAnd:
+            return MakeInteger(&heap_, integer1 & integer2);
+
+        case OpCode::BitwiseOr:
+            return MakeInteger(&heap_, integer1 | integer2);
+
+        case OpCode::BitwiseXor:
+            return MakeInteger(&heap_, integer1 ^ integer2);
+
+        default:
+            break;
+        }
+    } else if (AreNumbers(value1, value2)) {
+        double floatingPoint1 = ValueToFloatingPoint(value1);
+        double floatingPoint2 = ValueToFloatingPoint(value2);
+
+        switch (instruction->opCode) {
+        case OpCode::Add:
+            return Value::MakeFloatingPoint(floatingPoint1 + floatingPoint2);
+
+        case OpCode::Subtract:
+            return Value::MakeFloatingPoint(floatingPoint1 - floatingPoint2);
+
+        case OpCode::Multiply:
+            return Value::MakeFloatingPoint(floatingPoint1 * floatingPoint2);
+
+        case OpCode::Divide:
+            return Value::MakeFloatingPoint(floatingPoint1 / floatingPoint2);
+
+        case OpCode::Modulo:
+            return Value::MakeFloatingPoint(std::fmod(floatingPoint1, floatingPoint2));
+
+        default:
+            break;
+        }
+    } else if (instruction->opCode == OpCode::Add && value1.getType() == ValueType::String
+               && value2.getType() == ValueType::String) {
+        String *string1 = value1.getString();
+        String *string2 = value2.getString();
+        std::size_t length = string1->getLength() + string2->getLength();
+        collectGarbageIfNeeded();
+        auto string = heap_.createObject<String>();
+
+        if (length < MinRopeLength) {
+            string->value.reserve(length);
+            string->value.append(string1->getValue()).append(string2->getValue());
+        } else {
+            string->ropeLeft = string1;
+            string->ropeRight = string2;
+            string->ropeLength = length;
+        }
+
+        return Value::MakeObject(ValueType::String, string);
+    }
+
+    raiseError(instruction, "unsupported operand types");
+}
+
+
+bool
+Interpreter::compareValues(const Instruction *instruction, Value value1, Value value2)
+{
+    bool orEqual = instruction->opCode == OpCode::LessEqual;
+
+    if (AreIntegers(value1, value2)) {
+        std::int64_t integer1 = value1.getInteger();
+        std::int64_t integer2 = value2.getInteger();
+        return orEqual ? integer1 <= integer2 : integer1 < integer2;
+    }
+
+    if (AreNumbers(value1, value2)) {
+        double floatingPoint1 = ValueToFloatingPoint(value1);
+        double floatingPoint2 = ValueToFloatingPoint(value2);
+        return orEqual ? floatingPoint1 <= floatingPoint2 : floatingPoint1 < floatingPoint2;
+    }
+
+    if (value1.getType() == ValueType::String && value2.getType() == ValueType::String) {
+        int result = value1.getString()->getValue().compare(value2.getString()->getValue());
+        return orEqual ? result <= 0 : result < 0;
+    }
+
+    raiseError(instruction, "values are not comparable");
+}
+
+
+Value
+Interpreter::convertValue(const Instruction *instruction, Value value)
+{
+    switch (instruction->opCode) {
+    case OpCode::Positive:
+        if (value.getType() == ValueType::Integer
+            || value.getType() == ValueType::FloatingPoint) {
+            return value;
+        }
+
+        break;
+
+    case OpCode::Negate:
+        if (value.getType() == ValueType::Integer) {
+            return MakeInteger(&heap_, SubtractIntegers(0, value.getInteger()));
+        }
+
+        if (value.getType() == ValueType::FloatingPoint) {
+            return Value::MakeFloatingPoint(-value.getFloatingPoint());
+        }
+
+        break;
+
+    case OpCode::BitwiseNot:
+        if (value.getType() == ValueType::Integer) {
+            return MakeInteger(&heap_, ~value.getInteger());
+        }
+
+        break;
+
+    case OpCode::Increment:
+    case OpCode::Decrement: {
+            int delta = instruction->opCode == OpCode::Increment ? 1 : -1;
+
+            if (value.getType() == ValueType::Integer) {
+                return MakeInteger(&heap_, AddIntegers(value.getInteger(), delta));
+            }
+
+            if (value.getType() == ValueType::FloatingPoint) {
+                return Value::MakeFloatingPoint(value.getFloatingPoint() + delta);
+            }
+        }
+
+        break;
+
+    case OpCode::ToInteger:
+        switch (value.getType()) {
+        case ValueType::Boolean:
+            return Value::MakeSmallInteger(value.getBoolean());
+
+        case ValueType::Integer:
+            return value;
+
+        case ValueType::FloatingPoint: {
+                double floatingPoint = value.getFloatingPoint();
+
+                if (!(floatingPoint >= -0x1p63 && floatingPoint < 0x1p63)) {
+                    raiseError(instruction, "integer overflow");
+                }
+
+                return MakeInteger(&heap_, static_cast<std::int64_t>(floatingPoint));
+            }
+
+        case ValueType::String: {
+                const std::string &string = value.getString()->getValue();
+                std::int64_t integer;
+                std::from_chars_result result = std::from_chars(string.data()
+                                                                , string.data() + string.size()
+                                                                , integer);
+
+                if (result.ec != std::errc() || result.ptr != string.data() + string.size()) {
+                    raiseError(instruction, "invalid integer");
+                }
+
+                return MakeInteger(&heap_, integer);
+            }
+
+        default:
+            break;
+        }
+
+        break;
+
+    case OpCode::ToFloatingPoint:
+        switch (value.getType()) {
+        case ValueType::Boolean:
+            return Value::MakeFloatingPoint(value.getBoolean());
+
+        case ValueType::Integer:
+            return Value::MakeFloatingPoint(static_cast<double>(value.getInteger()));
+
+        case ValueType::FloatingPoint:
+            return value;
+
+        case ValueType::String: {
+                const std::string &string = value.getString()->getValue();
+                char *end;
+                double floatingPoint = std::strtod(string.c_str(), &end);
+
+                if (string.empty() || end != string.c_str() + string.size()) {
+                    raiseError(instruction, "invalid floating-point number");
+                }
+
+                return Value::MakeFloatingPoint(floatingPoint);
+            }
+
+        default:
+            break;
+        }
+
+        break;
+
+    case OpCode::ToString: {
+            char buffer[32];
+            std::to_chars_result result;
+
+            switch (value.getType()) {
+            case ValueType::Null:
+                return createString("null");
+
+            case ValueType::Boolean:
+                return createString(value.getBoolean() ? "true" : "false");
+
+            case ValueType::Integer:
+                result = std::to_chars(buffer, buffer + sizeof buffer, value.getInteger());
+                break;
+
+            case ValueType::FloatingPoint:
+                result = std::to_chars(buffer, buffer + sizeof buffer, value.getFloatingPoint());
+                break;
+
+            case ValueType::String:
+                return value;
+
+            default:
+                raiseError(instruction, "value is not convertible to string");
+            }
+
+            collectGarbageIfNeeded();
+            return createString(std::string_view(buffer, result.ptr - buffer));
+        }
+
+    case OpCode::Sizeof:
+        switch (value.getType()) {
+        case ValueType::String:
+            return MakeInteger(&heap_, value.getString()->getLength());
+
+        case ValueType::Array:
+            return MakeInteger(&heap_, value.getArray()->elements.size());
+
+        case ValueType::Dictionary:
+            {
+                const Dictionary *dictionary = value.getDictionary();
+                return MakeInteger(&heap_, dictionary->shape == nullptr
+                                           ? dictionary->elements.getSize()
+                                           : dictionary->values.size());
+            }
+
+        default:
+            break;
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    raiseError(instruction, "unsupported operand type");
+}
+
+
+bool
+Interpreter::getField(InlineCache *inlineCache, Value object, Value *value)
+{
+    if (object.getType() != ValueType::Dictionary) {
+        return false;
+    }
+
+    const Dictionary *dictionary = object.getDictionary();
+    const InlineCache::Entry *entry = ProbeInlineCache(*inlineCache, dictionary->shape);
+
+    if (entry != nullptr) {
+#if defined(OYC_COUNT_INLINE_CACHE_ACCESSES)
+        ++numberOfInlineCacheHits_;
+#endif
+        *value = dictionary->values[entry->index];
+        return true;
+    }
+
+#if defined(OYC_COUNT_INLINE_CACHE_ACCESSES)
+    ++numberOfInlineCacheMisses_;
+#endif
+
+    if (dictionary->shape == nullptr) {
+        return false;
+    }
+
+    int index = dictionary->shape->findKey(inlineCache->key);
+
+    if (index < 0) {
+        return false;
+    }
+
+    UpdateInlineCache(inlineCache, {dictionary->shape, nullptr, index});
+    *value = dictionary->values[index];
+    return true;
+}
+
+
+bool
+Interpreter::setField(InlineCache *inlineCache, Value object, Value value)
+{
+    if (object.getType() != ValueType::Dictionary || value.isNull()) {
+        return false;
+    }
+
+    Dictionary *dictionary = object.getDictionary();
+    const InlineCache::Entry *entry = ProbeInlineCache(*inlineCache, dictionary->shape);
+
+    if (entry != nullptr) {
+#if defined(OYC_COUNT_INLINE_CACHE_ACCESSES)
+        ++numberOfInlineCacheHits_;
+#endif
+
+        if (entry->newShape == nullptr) {
+            dictionary->values[entry->index] = value;
+        } else {
+            dictionary->shape = entry->newShape;
+            dictionary->values.push_back(value);
+        }
+
+        return true;
+    }
+
+#if defined(OYC_COUNT_INLINE_CACHE_ACCESSES)
+    ++numberOfInlineCacheMisses_;
+#endif
+
+    if (dictionary->shape == nullptr) {
+        return false;
+    }
+
+    int index = dictionary->shape->findKey(inlineCache->key);
+
+    if (index >= 0) {
+        UpdateInlineCache(inlineCache, {dictionary->shape, nullptr, index});
+        dictionary->values[index] = value;
+        return true;
+    }
+
+    int numberOfKeys = dictionary->shape->getNumberOfKeys();
+
+    if (numberOfKeys == MaxNumberOfShapedKeys) {
+        return false;
+    }
+
+    // Field keys are prototype constants, which stay alive as long as the shapes do.
+    Shape *newShape = dictionary->shape->addKey(inlineCache->key);
+    UpdateInlineCache(inlineCache, {dictionary->shape, newShape, numberOfKeys});
+    dictionary->shape = newShape;
+    dictionary->values.push_back(value);
+    return true;
+}
+
+
+Value
+Interpreter::getElement(const Instruction *instruction, Value object, Value key)
+{
+    switch (object.getType()) {
+    case ValueType::String: {
+            const std::string &string = object.getString()->getValue();
+            std::size_t index;
+
+            if (!GetArrayIndex(key, string.size(), &index)) {
+                raiseError(instruction, "index out of range");
+            }
+
+            collectGarbageIfNeeded();
+            return createString(std::string_view(&string[index], 1));
+        }
+
+    case ValueType::Array: {
+            const std::vector<Value> &elements = object.getArray()->elements;
+            std::size_t index;
+
+            if (!GetArrayIndex(key, elements.size(), &index)) {
+                raiseError(instruction, "index out of range");
+            }
+
+            return elements[index];
+        }
+
+    case ValueType::Dictionary: {
+            const Dictionary *dictionary = object.getDictionary();
+
+            if (dictionary->shape != nullptr) {
+                int index = dictionary->shape->findKey(key);
+                return index < 0 ? Value() : dictionary->values[index];
+            }
+
+            return dictionary->elements.get(key);
+        }
+
+    default:
+        raiseError(instruction, "value is not indexable");
+    }
+}
+
+
+void
+Interpreter::setElement(const Instruction *instruction, Value object, Value key, Value value)
+{
+    switch (object.getType()) {
+    case ValueType::Array: {
+            Array *array = object.getArray();
+            std::size_t index;
+
+            if (!GetArrayIndex(key, array->elements.size() + 1, &index)) {
+                raiseError(instruction, "index out of range");
+            }
+
+            array->setElement(index, value);
+            return;
+        }
+
+    case ValueType::Dictionary: {
+            Dictionary *dictionary = object.getDictionary();
+
+            if (dictionary->shape != nullptr) {
+                int index = dictionary->shape->findKey(key);
+
+                if (index >= 0 && !value.isNull()) {
+                    dictionary->values[index] = value;
+                    return;
+                }
+
+                if (index < 0 && value.isNull()) {
+                    return;
+                }
+
+                if (index == dictionary->shape->getNumberOfKeys() - 1 && value.isNull()) {
+                    dictionary->shape = dictionary->shape->getParent();
+                    dictionary->values.pop_back();
+                    return;
+                }
+
+                ConvertToHashTable(dictionary);
+            }
+
+            if (value.isNull()) {
+                dictionary->elements.erase(key);
+            } else {
+                dictionary->elements.set(key, value);
+            }
+
+            return;
+        }
+
+    default:
+        raiseError(instruction, "value is not indexable");
+    }
+}
+
+
+bool
+Interpreter::advanceIterator(const Instruction *instruction, Value *iterator)
+{
+    Value collection = iterator[2];
+    std::int64_t index = iterator[3].getSmallInteger();
+
+    switch (collection.getType()) {
+    case ValueType::String: {
+            const std::string &string = collection.getString()->getValue();
+
+            if (static_cast<std::uint64_t>(index) >= string.size()) {
+                return false;
+            }
+
+            collectGarbageIfNeeded();
+            iterator[0] = Value::MakeSmallInteger(index);
+            iterator[1] = createString(std::string_view(&string[index], 1));
+            iterator[3] = Value::MakeSmallInteger(index + 1);
+            return true;
+        }
+
+    case ValueType::Array: {
+            const std::vector<Value> &elements = collection.getArray()->elements;
+
+            if (static_cast<std::uint64_t>(index) >= elements.size()) {
+                return false;
+            }
+
+            iterator[0] = Value::MakeSmallInteger(index);
+            iterator[1] = elements[index];
+            iterator[3] = Value::MakeSmallInteger(index + 1);
+            return true;
+        }
+
+    case ValueType::Dictionary: {
+            const Dictionary *dictionary = collection.getDictionary();
+
+            if (dictionary->shape != nullptr) {
+                // Converting to a hash table keeps the key order, so the cursor stays valid if
+                // the loop body takes the dictionary out of shape mode.
+                if (static_cast<std::uint64_t>(index) >= dictionary->values.size()) {
+                    return false;
+                }
+
+                iterator[0] = dictionary->shape->getKeys()[index];
+                iterator[1] = dictionary->values[index];
+                iterator[3] = Value::MakeSmallInteger(index + 1);
+                return true;
+            }
+
+            const ValueMap &elements = dictionary->elements;
+            auto entryIndex = static_cast<std::size_t>(index);
+
+            for (; entryIndex < elements.getNumberOfEntries(); ++entryIndex) {
+                const ValueMap::Entry &entry = elements.getEntry(entryIndex);
+
+                if (!entry.value.isNull()) {
+                    iterator[0] = entry.key;
+                    iterator[1] = entry.value;
+                    iterator[3] = Value::MakeSmallInteger(entryIndex + 1);
+                    return true;
+                }
+            }
+
+            iterator[3] = Value::MakeSmallInteger(entryIndex);
+            return false;
+        }
+
+    default:
+        raiseError(instruction, "value is not iterable");
+    }
+}
+
+
+namespace {
+
+void
+BuildPrototype(Heap *heap, const Function &function, Prototype *prototype)
+{
+    prototype->function = &function;
+    prototype->constants.reserve(function.constants.size());
+
+    for (const Constant &constant : function.constants) {
+        switch (constant.type) {
+        case ConstantType::Integer:
+            prototype->constants.push_back(MakeInteger(heap, constant.integer));
+            break;
+
+        case ConstantType::FloatingPoint:
+            prototype->constants.push_back(Value::MakeFloatingPoint(constant.floatingPoint));
+            break;
+
+        case ConstantType::String: {
+                auto string = heap->createObject<String>();
+                string->value = constant.string;
+                prototype->constants.push_back(Value::MakeObject(ValueType::String, string));
+            }
+
+            break;
+
+        default:
+            prototype->constants.emplace_back();
+            break;
+        }
+    }
+
+    prototype->inlineCaches.resize(function.fieldKeyIndexes.size());
+
+    for (std::size_t i = 0; i < function.fieldKeyIndexes.size(); ++i) {
+        prototype->inlineCaches[i].key = prototype->constants[function.fieldKeyIndexes[i]];
+    }
+
+    prototype->prototypes.resize(function.functions.size());
+
+    for (std::size_t i = 0; i < function.functions.size(); ++i) {
+        BuildPrototype(heap, function.functions[i], &prototype->prototypes[i]);
+    }
+
+    return;
+}
+
+
+void
+MarkPrototype(Heap *heap, const Prototype &prototype)
+{
+    for (Value constant : prototype.constants) {
+        heap->markValue(constant);
+    }
+
+    for (const Prototype &subprototype : prototype.prototypes) {
+        MarkPrototype(heap, subprototype);
+    }
+
+    return;
+}
+
+
+Value
+MakeInteger(Heap *heap, std::int64_t integer)
+{
+    if (Value::IsSmallInteger(integer)) {
+        return Value::MakeSmallInteger(integer);
+    }
+
+    auto boxedInteger = heap->createObject<BoxedInteger>();
+    boxedInteger->value = integer;
+    return Value::MakeObject(ValueType::Integer, boxedInteger);
+}
+
+
+bool
+ValueToBoolean(Value value) noexcept
+{
+    switch (value.getType()) {
+    case ValueType::Null:
+        return false;
+
+    case ValueType::Boolean:
+        return value.getBoolean();
+
+    case ValueType::Integer:
+        return value.getInteger() != 0;
+
+    case ValueType::FloatingPoint:
+        return value.getFloatingPoint() != 0.0;
+
+    case ValueType::String:
+        return value.getString()->getLength() != 0;
+
+    default:
+        return true;
+    }
+}
+
+
+bool
+AreSmallIntegers(Value value1, Value value2) noexcept
+{
+    return value1.isSmallInteger() && value2.isSmallInteger();
+}
+
+
+bool
+AreIntegers(Value value1, Value value2) noexcept
+{
+    return value1.getType() == ValueType::Integer && value2.getType() == ValueType::Integer;
+}
+
+
+bool
+AreNumbers(Value value1, Value value2) noexcept
+{
+    return (value1.getType() == ValueType::Integer || value1.getType() == ValueType::FloatingPoint)
+           && (value2.getType() == ValueType::Integer
+               || value2.getType() == ValueType::FloatingPoint);
+}
+
+
+double
+ValueToFloatingPoint(Value value) noexcept
+{
+    return value.getType() == ValueType::Integer ? static_cast<double>(value.getInteger())
+                                                 : value.getFloatingPoint();
+}
+
+
+std::int64_t
+AddIntegers(std::int64_t integer1, std::int64_t integer2) noexcept
+{
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(integer1)
+                                     + static_cast<std::uint64_t>(integer2));
+}
+
+
+std::int64_t
+SubtractIntegers(std::int64_t integer1, std::int64_t integer2) noexcept
+{
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(integer1)
+                                     - static_cast<std::uint64_t>(integer2));
+}
+
+
+std::int64_t
+MultiplyIntegers(std::int64_t integer1, std::int64_t integer2) noexcept
+{
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(integer1)
+                                     * static_cast<std::uint64_t>(integer2));
+}
+
+
+std::int64_t
+ShiftIntegerLeft(std::int64_t integer1, std::int64_t integer2) noexcept
+{
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(integer1) << (integer2 & 63));
+}
+
+
+bool
+GetArrayIndex(Value key, std::size_t size, std::size_t *index) noexcept
+{
+    if (key.getType() != ValueType::Integer || key.getInteger() < 0
+        || static_cast<std::uint64_t>(key.getInteger()) >= size) {
+        return false;
+    }
+
+    *index = static_cast<std::size_t>(key.getInteger());
+    return true;
+}
+
+
+int
+LookUpSwitchTable(const SwitchTable &switchTable, Value value)
+{
+    switch (value.getType()) {
+    case ValueType::Integer:
+        return LookUpIntegerCase(switchTable, value.getInteger());
+
+    case ValueType::FloatingPoint: {
+            double floatingPoint = value.getFloatingPoint();
+
+            if (!(floatingPoint >= -0x1p63 && floatingPoint < 0x1p63)) {
+                return switchTable.defaultTarget;
+            }
+
+            auto integer = static_cast<std::int64_t>(floatingPoint);
+
+            if (static_cast<double>(integer) != floatingPoint) {
+                return switchTable.defaultTarget;
+            }
+
+            return LookUpIntegerCase(switchTable, integer);
+        }
+
+    case ValueType::String: {
+            auto it = switchTable.stringTargets.find(value.getString()->getValue());
+            return it == switchTable.stringTargets.end() ? switchTable.defaultTarget : it->second;
+        }
+
+    default:
+        return switchTable.defaultTarget;
+    }
+}
+
+
+int
+LookUpIntegerCase(const SwitchTable &switchTable, std::int64_t integer) noexcept
+{
+    if (!switchTable.denseTargets.empty()) {
+        std::uint64_t index = static_cast<std::uint64_t>(integer)
+                              - static_cast<std::uint64_t>(switchTable.minInteger);
+        return index < switchTable.denseTargets.size() ? switchTable.denseTargets[index]
+                                                       : switchTable.defaultTarget;
+    }
+
+    auto it = std::lower_bound(switchTable.sparseTargets.begin(), switchTable.sparseTargets.end()
+                               , integer, [] (const std::pair<std::int64_t, int> &sparseTarget
+                                              , std::int64_t key) -> bool {
+        return sparseTarget.first < key;
+    });
+
+    if (it == switchTable.sparseTargets.end() || it->first != integer) {
+        return switchTable.defaultTarget;
+    }
+
+    return it->second;
+}
+
+
+void
+ConvertToHashTable(Dictionary *dictionary)
+{
+    const std::vector<Value> &keys = dictionary->shape->getKeys();
+    dictionary->elements.reserve(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        dictionary->elements.set(keys[i], dictionary->values[i]);
+    }
+
+    dictionary->shape = nullptr;
+    std::vector<Value>().swap(dictionary->values);
+    return;
+}
+
+
+const InlineCache::Entry *
+ProbeInlineCache(const InlineCache &inlineCache, const Shape *shape) noexcept
+{
+    for (int i = 0; i < inlineCache.numberOfEntries; ++i) {
+        const InlineCache::Entry &entry = inlineCache.entries[i];
+
+        if (entry.shape == shape) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void
+UpdateInlineCache(InlineCache *inlineCache, const InlineCache::Entry &newEntry) noexcept
+{
+    int numberOfEntries = std::min(inlineCache->numberOfEntries + 1
+                                   , InlineCache::MaxNumberOfEntries);
+    InlineCache::Entry *entries = inlineCache->entries;
+    std::copy_backward(entries, entries + numberOfEntries - 1, entries + numberOfEntries);
+    entries[0] = newEntry;
+    inlineCache->numberOfEntries = numberOfEntries;
+    return;
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,65 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Heap.h"
+#include "Shape.h"
+#include "Value.h"
+
+
+namespace OYC {
+
+struct Function;
+struct Instruction;
+struct Prototype;
+struct InlineCache;
+
+
+class Interpreter final
+{
+    Interpreter(const Interpreter &) = delete;
+    Interpreter &operator=(const Interpreter &) = delete;
+
+public:
+    explicit Interpreter();
+    ~Interpreter();
+
+    Value createString(std::string_view);
+    Value execute(const Function &, const std::vector<Value> &);
+    std::uint64_t getNumberOfExecutedInstructions() const;
+    std::uint64_t getNumberOfInlineCacheHits() const;
+    std::uint64_t getNumberOfInlineCacheMisses() const;
+
+private:
+    struct Frame;
+
+    Heap heap_;
+    const Prototype *prototype_;
+    std::uint64_t numberOfExecutedInstructions_;
+    std::vector<Value> registers_;
+    std::vector<Frame> frames_;
+    Shape rootShape_;
+    std::uint64_t numberOfInlineCacheHits_;
+    std::uint64_t numberOfInlineCacheMisses_;
+
+    Value run();
+    void enterFunction(const Closure *, std::size_t, int, Value, const Instruction *);
+    Array *createVarargs(const Value *, int, int);
+    void collectGarbageIfNeeded();
+    [[noreturn]] void raiseError(const Instruction *, const char *) const;
+
+    Value performArithmetic(const Instruction *, Value, Value);
+    bool compareValues(const Instruction *, Value, Value);
+    Value convertValue(const Instruction *, Value);
+    bool getField(InlineCache *, Value, Value *);
+    bool setField(InlineCache *, Value, Value);
+    Value getElement(const Instruction *, Value, Value);
+    void setElement(const Instruction *, Value, Value, Value);
+    bool advanceIterator(const Instruction *, Value *);
+};
+
+} // namespace OYC
@@ -0,0 +1,32 @@
+#include "NewlineIndex.h"
+
+#include <algorithm>
+
+#include "CharSearch.h"
+
+
+namespace OYC {
+
+void
+NewlineIndex::addNewlines(const char *first, const char *last, std::size_t offset)
+{
+    for (const char *p = FindChar(first, last, '\n'); p < last; p = FindChar(p + 1, last, '\n')) {
+        newlineOffsets_.push_back(offset + (p - first));
+    }
+
+    return;
+}
+
+
+void
+NewlineIndex::locate(std::size_t offset, int *lineNumber, int *columnNumber) const
+{
+    std::vector<std::size_t>::const_iterator it = std::lower_bound(newlineOffsets_.begin()
+                                                                   , newlineOffsets_.end(), offset);
+    *lineNumber = 1 + static_cast<int>(it - newlineOffsets_.begin());
+    *columnNumber = 1 + static_cast<int>(it == newlineOffsets_.begin() ? offset
+                                                                       : offset - it[-1] - 1);
+    return;
+}
+
+} // namespace OYC
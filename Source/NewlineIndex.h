@@ -0,0 +1,46 @@
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace OYC {
+
+class NewlineIndex final
+{
+    NewlineIndex(const NewlineIndex &) = delete;
+    NewlineIndex &operator=(const NewlineIndex &) = delete;
+
+public:
+    inline explicit NewlineIndex();
+
+    inline void clear() noexcept;
+    inline void addNewline(std::size_t);
+    void addNewlines(const char *, const char *, std::size_t);
+    void locate(std::size_t, int *, int *) const;
+
+private:
+    std::vector<std::size_t> newlineOffsets_;
+};
+
+
+NewlineIndex::NewlineIndex()
+{
+}
+
+
+void
+NewlineIndex::clear() noexcept
+{
+    newlineOffsets_.clear();
+}
+
+
+void
+NewlineIndex::addNewline(std::size_t offset)
+{
+    newlineOffsets_.push_back(offset);
+}
+
+} // namespace OYC
@@ -0,0 +1,169 @@
+#include "Object.h"
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+
+namespace OYC {
+
+namespace {
+
+std::size_t HashInteger(std::uint64_t) noexcept;
+bool GetExactInteger(double, std::int64_t *) noexcept;
+
+} // namespace
+
+
+void
+String::flatten()
+{
+    std::string flatValue;
+    flatValue.reserve(ropeLength);
+    std::vector<const String *> pendingStrings(1, this);
+
+    while (!pendingStrings.empty()) {
+        const String *string = pendingStrings.back();
+        pendingStrings.pop_back();
+
+        if (string->ropeLeft == nullptr) {
+            flatValue.append(string->value);
+        } else {
+            pendingStrings.push_back(string->ropeRight);
+            pendingStrings.push_back(string->ropeLeft);
+        }
+    }
+
+    value.swap(flatValue);
+    ropeLeft = nullptr;
+    ropeRight = nullptr;
+    ropeLength = 0;
+    return;
+}
+
+
+std::size_t
+HashValue(Value value)
+{
+    switch (value.getType()) {
+    case ValueType::Null:
+        return 0;
+
+    case ValueType::Boolean:
+        return value.getBoolean() ? 1 : 2;
+
+    case ValueType::Integer:
+        return HashInteger(value.getInteger());
+
+    case ValueType::FloatingPoint: {
+            std::int64_t integer;
+
+            if (GetExactInteger(value.getFloatingPoint(), &integer)) {
+                return HashInteger(integer);
+            }
+
+            double floatingPoint = value.getFloatingPoint();
+            std::uint64_t bits;
+            std::memcpy(&bits, &floatingPoint, sizeof bits);
+            return HashInteger(bits);
+        }
+
+    case ValueType::String: {
+            String *string = value.getString();
+
+            if (string->hash == 0) {
+                string->hash = std::hash<std::string_view>()(string->getValue());
+            }
+
+            return string->hash;
+        }
+
+    default:
+        return HashInteger(reinterpret_cast<std::uintptr_t>(value.getObject()));
+    }
+}
+
+
+bool
+ValuesAreEqual(Value value1, Value value2)
+{
+    ValueType type1 = value1.getType();
+    ValueType type2 = value2.getType();
+
+    if (type1 != type2) {
+        std::int64_t integer;
+
+        if (type1 == ValueType::Integer && type2 == ValueType::FloatingPoint) {
+            return GetExactInteger(value2.getFloatingPoint(), &integer)
+                   && integer == value1.getInteger();
+        }
+
+        if (type1 == ValueType::FloatingPoint && type2 == ValueType::Integer) {
+            return GetExactInteger(value1.getFloatingPoint(), &integer)
+                   && integer == value2.getInteger();
+        }
+
+        return false;
+    }
+
+    switch (type1) {
+    case ValueType::Null:
+        return true;
+
+    case ValueType::Boolean:
+        return value1.getBoolean() == value2.getBoolean();
+
+    case ValueType::Integer:
+        return value1.getInteger() == value2.getInteger();
+
+    case ValueType::FloatingPoint:
+        return value1.getFloatingPoint() == value2.getFloatingPoint();
+
+    case ValueType::String: {
+            String *string1 = value1.getString();
+            String *string2 = value2.getString();
+
+            if (string1 == string2) {
+                return true;
+            }
+
+            if (string1->getLength() != string2->getLength()
+                || (string1->hash != 0 && string2->hash != 0 && string1->hash != string2->hash)) {
+                return false;
+            }
+
+            return string1->getValue() == string2->getValue();
+        }
+
+    default:
+        return value1.getObject() == value2.getObject();
+    }
+}
+
+
+namespace {
+
+std::size_t
+HashInteger(std::uint64_t integer) noexcept
+{
+    integer ^= integer >> 33;
+    integer *= UINT64_C(0xFF51AFD7ED558CCD);
+    integer ^= integer >> 33;
+    return static_cast<std::size_t>(integer);
+}
+
+
+bool
+GetExactInteger(double floatingPoint, std::int64_t *integer) noexcept
+{
+    if (!(floatingPoint >= -0x1p63 && floatingPoint < 0x1p63)) {
+        return false;
+    }
+
+    *integer = static_cast<std::int64_t>(floatingPoint);
+    return static_cast<double>(*integer) == floatingPoint;
+}
+
+} // namespace
+
+} // namespace OYC
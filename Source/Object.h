@@ -0,0 +1,237 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Value.h"
+#include "ValueMap.h"
+
+
+namespace OYC {
+
+struct Prototype;
+
+class Shape;
+
+
+enum class ObjectType : std::uint8_t
+{
+    BoxedInteger,
+    String,
+    Array,
+    Dictionary,
+    Closure,
+    Cell
+};
+
+
+enum class ArrayKind : std::uint8_t
+{
+    SmallInteger,
+    FloatingPoint,
+    Generic
+};
+
+
+struct Object
+{
+    ObjectType type;
+    bool isMarked = false;
+    Object *next = nullptr;
+};
+
+
+struct BoxedInteger : Object
+{
+    static constexpr ObjectType Type = ObjectType::BoxedInteger;
+
+    std::int64_t value = 0;
+};
+
+
+struct String : Object
+{
+    static constexpr ObjectType Type = ObjectType::String;
+
+    std::string value;
+    std::size_t hash = 0;
+    // A concatenation keeps its operands until its contents are needed.
+    String *ropeLeft = nullptr;
+    String *ropeRight = nullptr;
+    std::size_t ropeLength = 0;
+
+    inline std::size_t getLength() const noexcept;
+    inline const std::string &getValue();
+    void flatten();
+};
+
+
+struct Array : Object
+{
+    static constexpr ObjectType Type = ObjectType::Array;
+
+    ArrayKind kind = ArrayKind::SmallInteger;
+    std::vector<Value> elements;
+
+    static inline ArrayKind GetElementKind(Value) noexcept;
+
+    inline void setElement(std::size_t, Value);
+};
+
+
+struct Dictionary : Object
+{
+    static constexpr ObjectType Type = ObjectType::Dictionary;
+
+    Shape *shape = nullptr;
+    std::vector<Value> values;
+    ValueMap elements;
+};
+
+
+struct Closure : Object
+{
+    static constexpr ObjectType Type = ObjectType::Closure;
+
+    const Prototype *prototype = nullptr;
+    std::size_t numberOfUpvalues = 0;
+
+    inline Value *getUpvalues() noexcept;
+    inline const Value *getUpvalues() const noexcept;
+};
+
+static_assert(sizeof(Closure) % alignof(Value) == 0);
+
+
+struct Cell : Object
+{
+    static constexpr ObjectType Type = ObjectType::Cell;
+
+    Value value;
+};
+
+
+std::size_t HashValue(Value);
+bool ValuesAreEqual(Value, Value);
+
+
+std::size_t
+String::getLength() const noexcept
+{
+    return ropeLeft == nullptr ? value.size() : ropeLength;
+}
+
+
+const std::string &
+String::getValue()
+{
+    if (ropeLeft != nullptr) {
+        flatten();
+    }
+
+    return value;
+}
+
+
+ArrayKind
+Array::GetElementKind(Value element) noexcept
+{
+    if (element.isSmallInteger()) {
+        return ArrayKind::SmallInteger;
+    }
+
+    if (element.getType() == ValueType::FloatingPoint) {
+        return ArrayKind::FloatingPoint;
+    }
+
+    return ArrayKind::Generic;
+}
+
+
+void
+Array::setElement(std::size_t index, Value element)
+{
+    if (kind != ArrayKind::Generic) {
+        ArrayKind elementKind = GetElementKind(element);
+
+        if (elementKind != kind) {
+            kind = elements.empty() ? elementKind : ArrayKind::Generic;
+        }
+    }
+
+    if (index == elements.size()) {
+        elements.push_back(element);
+    } else {
+        elements[index] = element;
+    }
+
+    return;
+}
+
+
+Value *
+Closure::getUpvalues() noexcept
+{
+    return reinterpret_cast<Value *>(this + 1);
+}
+
+
+const Value *
+Closure::getUpvalues() const noexcept
+{
+    return reinterpret_cast<const Value *>(this + 1);
+}
+
+
+std::int64_t
+Value::getInteger() const noexcept
+{
+    return isSmallInteger() ? getSmallInteger() : getBoxedInteger()->value;
+}
+
+
+BoxedInteger *
+Value::getBoxedInteger() const noexcept
+{
+    return static_cast<BoxedInteger *>(getObject());
+}
+
+
+String *
+Value::getString() const noexcept
+{
+    return static_cast<String *>(getObject());
+}
+
+
+Array *
+Value::getArray() const noexcept
+{
+    return static_cast<Array *>(getObject());
+}
+
+
+Dictionary *
+Value::getDictionary() const noexcept
+{
+    return static_cast<Dictionary *>(getObject());
+}
+
+
+Closure *
+Value::getClosure() const noexcept
+{
+    return static_cast<Closure *>(getObject());
+}
+
+
+Cell *
+Value::getCell() const noexcept
+{
+    return static_cast<Cell *>(getObject());
+}
+
+} // namespace OYC
@@ -1,12 +1,14 @@
 #include "Parser.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
-#include <iterator>
+#include <string_view>
 
 #include "Error.h"
 #include "Expression.h"
 #include "Program.h"
+#include "Scanner.h"
 #include "ScopeGuard.h"
 #include "Statement.h"
 
@@ -26,25 +28,45 @@ class ParseContext final
 
 public:
     explicit ParseContext(ParseContext *, FunctionLiteral *);
+    ~ParseContext();
 
     int getNumberOfVariableNames() const;
-    void addVariableName(const std::string *);
+    void addVariableName(SymbolID);
     void deleteVariableNames(int);
-    const std::string *searchVariableName(const std::string &);
+    bool searchVariableName(SymbolID);
+    void initializeVariableName(SymbolID);
+    void assignVariableName(SymbolID);
 
 private:
+    struct VariableBinding
+    {
+        SymbolID name;
+        int depth;
+        int captureDepth;
+        int previousBindingIndex;
+        bool isCaptured;
+        bool isAssigned;
+    };
+
+    struct SymbolTable
+    {
+        std::vector<VariableBinding> bindings;
+        std::vector<int> symbolIDToBindingIndex;
+    };
+
     ParseContext *const super_;
     FunctionLiteral *const functionLiteral_;
-    std::vector<const std::string *> variableNames_;
+    const int depth_;
+    SymbolTable ownSymbolTable_;
+    SymbolTable *const symbolTable_;
+
+    VariableBinding *getVariableBinding(SymbolID);
 };
 
 
 namespace {
 
-void SetStatementPosition(Statement *, const Token &);
-void ExpectToken(const Token &, TokenType);
-void ExpectToken(const Token &, TokenType, TokenType);
-void EvaluateStringLiteral(const std::string &, std::string *);
+void EvaluateStringLiteral(std::string_view, std::string *);
 int UnescapeChar(const char **);
 
 bool isodigit(int);
@@ -59,6 +81,11 @@ Parser::readProgram()
 {
     Program program;
     programData_ = &program.data;
+    statementStack_.clear();
+    expressionStack_.clear();
+    expressionPairStack_.clear();
+    variableDeclaratorStack_.clear();
+    caseClauseStack_.clear();
     matchProgramMain(&program.main);
     return program;
 }
@@ -67,6 +94,10 @@ Parser::readProgram()
 Token
 Parser::doReadToken()
 {
+    if (scanner_ != nullptr) {
+        return scanner_->readSignificantToken();
+    }
+
     Token token = input_();
 
     while (token.type == TokenType::WhiteSpace || token.type == TokenType::Comment) {
@@ -80,27 +111,101 @@ Parser::doReadToken()
 const Token &
 Parser::peekToken(int position)
 {
-    for (int n = position - static_cast<int>(prereadTokens_.size()); n >= 1; --n) {
-        prereadTokens_.push_back(doReadToken());
+    for (; numberOfPrereadTokens_ < position; ++numberOfPrereadTokens_) {
+        prereadTokens_[(firstPrereadTokenIndex_ + numberOfPrereadTokens_)
+                       & (MaxNumberOfPrereadTokens - 1)] = doReadToken();
     }
 
-    return *std::next(prereadTokens_.begin(), position - 1);
+    return prereadTokens_[(firstPrereadTokenIndex_ + position - 1) & (MaxNumberOfPrereadTokens - 1)];
 }
 
 
 Token
 Parser::readToken()
 {
-    if (prereadTokens_.empty()) {
+    if (numberOfPrereadTokens_ == 0) {
         return doReadToken();
     } else {
-        Token token = std::move(prereadTokens_.front());
-        prereadTokens_.pop_front();
+        const Token &token = prereadTokens_[firstPrereadTokenIndex_];
+        firstPrereadTokenIndex_ = (firstPrereadTokenIndex_ + 1) & (MaxNumberOfPrereadTokens - 1);
+        --numberOfPrereadTokens_;
         return token;
     }
 }
 
 
+Token
+Parser::locateToken(Token token) const
+{
+    if (token.lineNumber == 0) {
+        if (scanner_ != nullptr) {
+            scanner_->locateToken(&token);
+        } else if (tokenLocator_ != nullptr) {
+            tokenLocator_(&token);
+        }
+    }
+
+    return token;
+}
+
+
+void
+Parser::setStatementPosition(Statement *statement, const Token &token) const
+{
+    if (token.lineNumber == 0) {
+        Token locatedToken = locateToken(token);
+        statement->lineNumber = locatedToken.lineNumber;
+        statement->columnNumber = locatedToken.columnNumber;
+    } else {
+        statement->lineNumber = token.lineNumber;
+        statement->columnNumber = token.columnNumber;
+    }
+
+    return;
+}
+
+
+void
+Parser::expectToken(const Token &token, TokenType tokenType) const
+{
+    if (token.type != tokenType) {
+        throw Error::UnexpectedToken(locateToken(token), tokenType);
+    }
+
+    return;
+}
+
+
+void
+Parser::expectToken(const Token &token, TokenType tokenType1, TokenType tokenType2) const
+{
+    if (token.type != tokenType1 && token.type != tokenType2) {
+        throw Error::UnexpectedToken(locateToken(token), tokenType1, tokenType2);
+    }
+
+    return;
+}
+
+
+template <class T>
+T *
+Parser::createNode()
+{
+    return programData_->arena.create<T>();
+}
+
+
+template <class T>
+ArenaArray<T>
+Parser::popArray(std::vector<T> *stack, std::size_t stackSize)
+{
+    ArenaArray<T> array = programData_->arena.makeArray(stack->data() + stackSize
+                                                        , stack->size() - stackSize);
+    stack->resize(stackSize);
+    return array;
+}
+
+
 void
 Parser::matchProgramMain(FunctionLiteral *match)
 {
@@ -113,33 +218,37 @@ Parser::matchProgramMain(FunctionLiteral *match)
 
 
 void
-Parser::matchStatements(std::vector<std::unique_ptr<Statement>> *match, TokenType terminator)
+Parser::matchStatements(ArenaArray<Statement *> *match, TokenType terminator)
 {
+    std::size_t statementStackSize = statementStack_.size();
+
     if (terminator == TokenType::No) {
-        std::unique_ptr<Statement> statement = matchStatement();
+        Statement *statement = matchStatement();
 
         if (statement != nullptr) {
-            match->push_back(std::move(statement));
+            statementStack_.push_back(statement);
         }
 
+        *match = popArray(&statementStack_, statementStackSize);
         return;
     } else {
         for (const Token *token = &peekToken(1); token->type != terminator
              ; token = &peekToken(1)) {
-            std::unique_ptr<Statement> statement = matchStatement();
+            Statement *statement = matchStatement();
 
             if (statement != nullptr) {
-                match->push_back(std::move(statement));
+                statementStack_.push_back(statement);
             }
         }
 
         readToken();
+        *match = popArray(&statementStack_, statementStackSize);
         return;
     }
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchStatement()
 {
     const Token *token = &peekToken(1);
@@ -185,29 +294,31 @@ Parser::matchStatement()
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchExpressionStatement()
 {
-    auto match = std::make_unique<ExpressionStatement>();
-    SetStatementPosition(match.get(), peekToken(1));
+    auto match = createNode<ExpressionStatement>();
+    setStatementPosition(match, peekToken(1));
     match->expression = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(';'));
+    expectToken(peekToken(1), MakeTokenType(';'));
     readToken();
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchAutoStatement()
 {
-    auto match = std::make_unique<AutoStatement>();
-    SetStatementPosition(match.get(), readToken());
+    auto match = createNode<AutoStatement>();
+    setStatementPosition(match, readToken());
+    std::size_t variableDeclaratorStackSize = variableDeclaratorStack_.size();
 
     for (;;) {
-        match->variableDeclarators.emplace_back();
-        matchVariableDeclarator(&match->variableDeclarators.back());
+        VariableDeclarator variableDeclarator;
+        matchVariableDeclarator(&variableDeclarator);
+        variableDeclaratorStack_.push_back(variableDeclarator);
         const Token *token = &peekToken(1);
-        ExpectToken(*token, MakeTokenType(','), MakeTokenType(';'));
+        expectToken(*token, MakeTokenType(','), MakeTokenType(';'));
 
         if (token->type == MakeTokenType(',')) {
             readToken();
@@ -217,42 +328,43 @@ Parser::matchAutoStatement()
     }
 
     readToken();
+    match->variableDeclarators = popArray(&variableDeclaratorStack_, variableDeclaratorStackSize);
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchBreakStatement()
 {
-    auto match = std::make_unique<BreakStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType(';'));
+    auto match = createNode<BreakStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType(';'));
     readToken();
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchContinueStatement()
 {
-    auto match = std::make_unique<BreakStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType(';'));
+    auto match = createNode<ContinueStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType(';'));
     readToken();
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchReturnStatement()
 {
-    auto match = std::make_unique<ReturnStatement>();
-    SetStatementPosition(match.get(), readToken());
+    auto match = createNode<ReturnStatement>();
+    setStatementPosition(match, readToken());
     const Token *token = &peekToken(1);
 
     if (token->type != MakeTokenType(';')) {
         match->result = matchExpression1();
-        ExpectToken(peekToken(1), MakeTokenType(';'));
+        expectToken(peekToken(1), MakeTokenType(';'));
     }
 
     readToken();
@@ -260,17 +372,17 @@ Parser::matchReturnStatement()
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchIfStatement()
 {
     ScopeGuard scopeGuard(VARIABLE_NAME_CLEANUP);
     scopeGuard.commit();
-    auto match = std::make_unique<IfStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    auto match = createNode<IfStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     match->condition = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(')'));
+    expectToken(peekToken(1), MakeTokenType(')'));
     readToken();
     matchBlock(&match->thenBody);
     const Token *token = &peekToken(1);
@@ -284,27 +396,29 @@ Parser::matchIfStatement()
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchSwitchStatement()
 {
-    auto match = std::make_unique<SwitchStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    auto match = createNode<SwitchStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     match->lhs = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(')'));
+    expectToken(peekToken(1), MakeTokenType(')'));
     readToken();
-    ExpectToken(peekToken(1), MakeTokenType('{'));
+    expectToken(peekToken(1), MakeTokenType('{'));
     readToken();
     const Token *token = &peekToken(1);
+    std::size_t caseClauseStackSize = caseClauseStack_.size();
 
     if (token->type != MakeTokenType('}')) {
-        ExpectToken(*token, TokenType::CaseKeyword, TokenType::DefaultKeyword);
+        expectToken(*token, TokenType::CaseKeyword, TokenType::DefaultKeyword);
         bool defaultLabelFlag = token->type == TokenType::DefaultKeyword;
 
         for (;;) {
-            match->caseClauses.emplace_back();
-            matchCaseClause(&match->caseClauses.back());
+            CaseClause caseClause;
+            matchCaseClause(&caseClause);
+            caseClauseStack_.push_back(caseClause);
             token = &peekToken(1);
 
             if (token->type == MakeTokenType('}')) {
@@ -312,7 +426,7 @@ Parser::matchSwitchStatement()
             } else {
                 if (token->type == TokenType::DefaultKeyword) {
                     if (defaultLabelFlag) {
-                        throw Error::DuplicateDefaultLabel(*token);
+                        throw Error::DuplicateDefaultLabel(locateToken(*token));
                     }
 
                     defaultLabelFlag = true;
@@ -322,63 +436,64 @@ Parser::matchSwitchStatement()
     }
 
     readToken();
+    match->caseClauses = popArray(&caseClauseStack_, caseClauseStackSize);
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchWhileStatement()
 {
     ScopeGuard scopeGuard(VARIABLE_NAME_CLEANUP);
     scopeGuard.commit();
-    auto match = std::make_unique<WhileStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    auto match = createNode<WhileStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     match->condition = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(')'));
+    expectToken(peekToken(1), MakeTokenType(')'));
     readToken();
     matchBlock(&match->body);
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchDoWhileStatement()
 {
     ScopeGuard scopeGuard(VARIABLE_NAME_CLEANUP);
     scopeGuard.commit();
-    auto match = std::make_unique<DoWhileStatement>();
+    auto match = createNode<DoWhileStatement>();
     readToken();
     matchBlock(&match->body);
-    ExpectToken(peekToken(1), TokenType::WhileKeyword);
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    expectToken(peekToken(1), TokenType::WhileKeyword);
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     match->condition = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(')'));
+    expectToken(peekToken(1), MakeTokenType(')'));
     readToken();
-    ExpectToken(peekToken(1), MakeTokenType(';'));
+    expectToken(peekToken(1), MakeTokenType(';'));
     readToken();
     return match;
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchForStatement()
 {
     ScopeGuard scopeGuard(VARIABLE_NAME_CLEANUP);
     scopeGuard.commit();
-    auto match = std::make_unique<ForStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    auto match = createNode<ForStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     const Token *token = &peekToken(1);
 
     if (token->type == MakeTokenType(';')) {
         readToken();
     } else {
-        ExpectToken(*token, TokenType::AutoKeyword);
+        expectToken(*token, TokenType::AutoKeyword);
         match->initialization = matchAutoStatement();
     }
 
@@ -386,7 +501,7 @@ Parser::matchForStatement()
 
     if (token->type != MakeTokenType(';')) {
         match->condition = matchExpression1();
-        ExpectToken(peekToken(1), MakeTokenType(';'));
+        expectToken(peekToken(1), MakeTokenType(';'));
     }
 
     readToken();
@@ -394,7 +509,7 @@ Parser::matchForStatement()
 
     if (token->type != MakeTokenType(')')) {
         match->iteration = matchExpression1();
-        ExpectToken(peekToken(1), MakeTokenType(')'));
+        expectToken(peekToken(1), MakeTokenType(')'));
     }
 
     readToken();
@@ -403,25 +518,31 @@ Parser::matchForStatement()
 }
 
 
-std::unique_ptr<Statement>
+Statement *
 Parser::matchForeachStatement()
 {
     ScopeGuard scopeGuard(VARIABLE_NAME_CLEANUP);
     scopeGuard.commit();
-    auto match = std::make_unique<ForeachStatement>();
-    SetStatementPosition(match.get(), readToken());
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    auto match = createNode<ForeachStatement>();
+    setStatementPosition(match, readToken());
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
-    ExpectToken(peekToken(1), TokenType::AutoKeyword);
+    expectToken(peekToken(1), TokenType::AutoKeyword);
     readToken();
     match->variableName1 = getVariableName();
-    ExpectToken(peekToken(1), MakeTokenType(','));
-    readToken();
-    match->variableName2 = getVariableName();
-    ExpectToken(peekToken(1), MakeTokenType(':'));
-    readToken();
+    expectToken(peekToken(1), MakeTokenType(','), MakeTokenType(':'));
+
+    if (readToken().type == MakeTokenType(',')) {
+        match->variableName2 = getVariableName();
+        expectToken(peekToken(1), MakeTokenType(':'));
+        readToken();
+    } else {
+        match->variableName2 = match->variableName1;
+        match->variableName1 = NoSymbolID;
+    }
+
     match->collection = matchExpression1();
-    ExpectToken(peekToken(1), MakeTokenType(')'));
+    expectToken(peekToken(1), MakeTokenType(')'));
     readToken();
     matchBlock(&match->body);
     return match;
@@ -437,6 +558,7 @@ Parser::matchVariableDeclarator(VariableDeclarator *match)
     if (token->type == MakeTokenType('=')) {
         readToken();
         match->initializer = matchExpression2();
+        context_->initializeVariableName(match->name);
     }
 
     return;
@@ -444,7 +566,7 @@ Parser::matchVariableDeclarator(VariableDeclarator *match)
 
 
 void
-Parser::matchBlock(std::vector<std::unique_ptr<Statement>> *match)
+Parser::matchBlock(ArenaArray<Statement *> *match)
 {
     const Token *token = &peekToken(1);
 
@@ -473,37 +595,39 @@ Parser::matchCaseClause(CaseClause *match)
         readToken();
     }
 
-    ExpectToken(peekToken(1), MakeTokenType(':'));
+    expectToken(peekToken(1), MakeTokenType(':'));
     readToken();
     token = &peekToken(1);
+    std::size_t statementStackSize = statementStack_.size();
 
     while (token->type != TokenType::CaseKeyword && token->type != TokenType::DefaultKeyword
            && token->type != MakeTokenType('}')) {
-        std::unique_ptr<Statement> statement = matchStatement();
+        Statement *statement = matchStatement();
 
         if (statement != nullptr) {
-            match->body.push_back(std::move(statement));
+            statementStack_.push_back(statement);
         }
 
         token = &peekToken(1);
     }
 
+    match->body = popArray(&statementStack_, statementStackSize);
     return;
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression1()
 {
-    std::unique_ptr<Expression> result = matchExpression2();
+    Expression *result = matchExpression2();
     const Token *token = &peekToken(1);
 
     while (token->type == MakeTokenType(',')) {
-        auto match = std::make_unique<BinaryExpression>();
-        match->operand1 = std::move(result);
+        auto match = createNode<BinaryExpression>();
+        match->operand1 = result;
         match->op = readToken().type;
         match->operand2 = matchExpression2();
-        result = std::move(match);
+        result = match;
         token = &peekToken(1);
     }
 
@@ -511,20 +635,20 @@ Parser::matchExpression1()
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression2()
 {
     int precedence = 0;
-    std::unique_ptr<Expression> result = matchExpression3(&precedence);
+    Expression *result = matchExpression3(&precedence);
     const Token *token = &peekToken(1);
 
     switch (token->type) {
     case MakeTokenType('?'): {
-            auto match = std::make_unique<TernaryExpression>();
-            match->operand1 = std::move(result);
+            auto match = createNode<TernaryExpression>();
+            match->operand1 = result;
             match->op[0] = readToken().type;
             match->operand2 = matchExpression2();
-            ExpectToken(peekToken(1), MakeTokenType(':'));
+            expectToken(peekToken(1), MakeTokenType(':'));
             match->op[1] = readToken().type;
             match->operand3 = matchExpression2();
             return match;
@@ -541,10 +665,11 @@ Parser::matchExpression2()
     case MakeTokenType('*', '='):
     case MakeTokenType('/', '='):
     case MakeTokenType('%', '='): {
-            auto match = std::make_unique<BinaryExpression>();
-            match->operand1 = std::move(result);
+            auto match = createNode<BinaryExpression>();
+            match->operand1 = result;
             match->op = readToken().type;
             match->operand2 = matchExpression2();
+            assignVariable(result);
             return match;
         }
 
@@ -554,11 +679,11 @@ Parser::matchExpression2()
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression3(int *precedence)
 {
     int lowestPrecedence = *precedence + 1;
-    std::unique_ptr<Expression> result = matchExpression4();
+    Expression *result = matchExpression4();
     const Token *token = &peekToken(1);
 
     switch (token->type) {
@@ -615,11 +740,11 @@ Parser::matchExpression3(int *precedence)
     }
 
     while (*precedence >= lowestPrecedence) {
-        auto match = std::make_unique<BinaryExpression>();
-        match->operand1 = std::move(result);
+        auto match = createNode<BinaryExpression>();
+        match->operand1 = result;
         match->op = readToken().type;
         match->operand2 = matchExpression3(precedence);
-        result = std::move(match);
+        result = match;
         token = &peekToken(1);
     }
 
@@ -627,7 +752,7 @@ Parser::matchExpression3(int *precedence)
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression4()
 {
     const Token *token = &peekToken(1);
@@ -641,11 +766,11 @@ Parser::matchExpression4()
         case TokenType::IntKeyword:
         case TokenType::FloatKeyword:
         case TokenType::StrKeyword: {
-                auto match = std::make_unique<UnaryExpression>();
+                auto match = createNode<UnaryExpression>();
                 match->type = UnaryExpressionType::Prefix;
                 readToken();
                 match->op = readToken().type;
-                ExpectToken(peekToken(1), MakeTokenType(')'));
+                expectToken(peekToken(1), MakeTokenType(')'));
                 readToken();
                 match->operand = matchExpression4();
                 return match;
@@ -662,10 +787,15 @@ Parser::matchExpression4()
     case MakeTokenType('!'):
     case MakeTokenType('~'):
     case TokenType::SizeofKeyword: {
-            auto match = std::make_unique<UnaryExpression>();
+            auto match = createNode<UnaryExpression>();
             match->type = UnaryExpressionType::Prefix;
             match->op = readToken().type;
             match->operand = matchExpression4();
+
+            if (match->op == MakeTokenType('+', '+') || match->op == MakeTokenType('-', '-')) {
+                assignVariable(match->operand);
+            }
+
             return match;
         }
 
@@ -675,46 +805,49 @@ Parser::matchExpression4()
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression5()
 {
-    std::unique_ptr<Expression> result = matchExpression6();
+    Expression *result = matchExpression6();
     const Token *token = &peekToken(1);
 
     for (;;) {
         switch (token->type) {
         case MakeTokenType('+', '+'):
         case MakeTokenType('-', '-'): {
-                auto match = std::make_unique<UnaryExpression>();
+                auto match = createNode<UnaryExpression>();
                 match->type = UnaryExpressionType::Postfix;
                 match->op = readToken().type;
-                match->operand = std::move(result);
-                result = std::move(match);
+                match->operand = result;
+                assignVariable(result);
+                result = match;
                 token = &peekToken(1);
                 break;
             }
 
         case MakeTokenType('.'):
         case MakeTokenType('['): {
-                auto match = std::make_unique<RetrievalExpression>();
-                match->retrievee = std::move(result);
+                auto match = createNode<RetrievalExpression>();
+                match->retrievee = result;
                 match->key = matchElementSelector();
-                result = std::move(match);
+                result = match;
                 token = &peekToken(1);
                 break;
             }
 
         case MakeTokenType('('): {
-                auto match = std::make_unique<InvocationExpression>();
-                match->invokee = std::move(result);
+                auto match = createNode<InvocationExpression>();
+                match->invokee = result;
                 readToken();
                 token = &peekToken(1);
+                std::size_t expressionStackSize = expressionStack_.size();
 
                 if (token->type != MakeTokenType(')')) {
                     for (;;) {
-                        match->arguments.push_back(matchArrayElement());
+                        Expression *argument = matchArrayElement();
+                        expressionStack_.push_back(argument);
                         token = &peekToken(1);
-                        ExpectToken(*token, MakeTokenType(','), MakeTokenType(')'));
+                        expectToken(*token, MakeTokenType(','), MakeTokenType(')'));
 
                         if (token->type == MakeTokenType(',')) {
                             readToken();
@@ -725,7 +858,8 @@ Parser::matchExpression5()
                 }
 
                 readToken();
-                result = std::move(match);
+                match->arguments = popArray(&expressionStack_, expressionStackSize);
+                result = match;
                 token = &peekToken(1);
                 break;
             }
@@ -737,7 +871,7 @@ Parser::matchExpression5()
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchExpression6()
 {
     const Token *token = &peekToken(1);
@@ -745,14 +879,14 @@ Parser::matchExpression6()
     switch (token->type) {
     case MakeTokenType('('): {
             readToken();
-            std::unique_ptr<Expression> result = matchExpression1();
-            ExpectToken(peekToken(1), MakeTokenType(')'));
+            Expression *result = matchExpression1();
+            expectToken(peekToken(1), MakeTokenType(')'));
             readToken();
             return result;
         }
 
     case TokenType::NullKeyword: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::Null;
             readToken();
             return match;
@@ -760,90 +894,90 @@ Parser::matchExpression6()
 
     case TokenType::FalseKeyword:
     case TokenType::TrueKeyword: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::Boolean;
             match->boolean = getBoolean();
             return match;
         }
 
     case TokenType::IntegerLiteral: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::Integer;
             match->integer = getInteger();
             return match;
         }
 
     case TokenType::FloatingPointLiteral: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::FloatingPoint;
             match->floatingPoint = getFloatingPoint();
             return match;
         }
 
     case TokenType::StringLiteral: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::String;
             match->string = getString();
             return match;
         }
 
     case TokenType::Identifier: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::VariableName;
             match->string = findVariableName();
             return match;
         }
 
     case MakeTokenType('{'): {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::ArrayLiteral;
             match->arrayLiteral = matchArrayLiteral();
             return match;
         }
 
     case TokenType::DictKeyword: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::DictionaryLiteral;
             match->dictionaryLiteral = matchDictionaryLiteral();
             return match;
         }
 
     case TokenType::FuncKeyword: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::FunctionLiteral;
             match->functionLiteral = matchFunctionLiteral();
             return match;
         }
 
     case TokenType::ThisKeyword: {
-            auto match = std::make_unique<PrimaryExpression>();
+            auto match = createNode<PrimaryExpression>();
             match->type = PrimaryExpressionType::This;
             readToken();
             return match;
         }
 
     default:
-        throw Error::UnexpectedToken(*token, "primary-expression");
+        throw Error::UnexpectedToken(locateToken(*token), "primary-expression");
     }
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchElementSelector()
 {
     const Token *token = &peekToken(1);
 
     if (token->type == MakeTokenType('.')) {
         readToken();
-        auto key = std::make_unique<PrimaryExpression>();
+        auto key = createNode<PrimaryExpression>();
         key->type = PrimaryExpressionType::String;
-        ExpectToken(peekToken(1), TokenType::Identifier);
+        expectToken(peekToken(1), TokenType::Identifier);
         key->string = getIdentifier();
         return key;
     } else {
         readToken();
-        std::unique_ptr<Expression> key = matchExpression1();
-        ExpectToken(peekToken(1), MakeTokenType(']'));
+        Expression *key = matchExpression1();
+        expectToken(peekToken(1), MakeTokenType(']'));
         readToken();
         return key;
     }
@@ -860,57 +994,62 @@ Parser::getBoolean()
 unsigned long
 Parser::getInteger()
 {
-    return std::strtoul(readToken().value.c_str(), nullptr, 0);
+    return std::strtoul(std::string(readToken().value).c_str(), nullptr, 0);
 }
 
 
 double
 Parser::getFloatingPoint()
 {
-    return std::strtod(readToken().value.c_str(), nullptr);
+    return std::strtod(std::string(readToken().value).c_str(), nullptr);
 }
 
 
-const std::string *
+SymbolID
 Parser::getString()
 {
-    std::string string;
-    EvaluateStringLiteral(readToken().value, &string);
+    std::string_view stringLiteral = readToken().value;
     const Token *token = &peekToken(1);
 
+    if (token->type != TokenType::StringLiteral
+        && stringLiteral.find('\\') == std::string_view::npos) {
+        return programData_->strings.intern(stringLiteral.substr(1, stringLiteral.size() - 2));
+    }
+
+    std::string string;
+    EvaluateStringLiteral(stringLiteral, &string);
+
     while (token->type == TokenType::StringLiteral) {
         EvaluateStringLiteral(readToken().value, &string);
         token = &peekToken(1);
     }
 
-    std::pair<std::unordered_set<std::string>::iterator
-              , bool> result = programData_->strings.insert(std::move(string));
-    return &*result.first;
+    return programData_->strings.intern(string);
 }
 
 
-const std::string *
+SymbolID
 Parser::getIdentifier()
 {
-    std::pair<std::unordered_set<std::string>::iterator
-              , bool> result = programData_->strings.insert(readToken().value);
-    return &*result.first;
+    return programData_->strings.intern(readToken().value);
 }
 
 
 const ArrayLiteral *
 Parser::matchArrayLiteral()
 {
-    programData_->arrayLiterals.emplace_back();
-    ArrayLiteral *match = &programData_->arrayLiterals.back();
+    ArrayLiteral *match = &programData_->arrayLiterals.emplaceBack();
+    match->id = programData_->arrayLiterals.getSize() - 1;
     readToken();
     const Token *token = &peekToken(1);
+    std::size_t expressionStackSize = expressionStack_.size();
 
     if (token->type != MakeTokenType('}')) {
         for (;;) {
-            match->elements.push_back(matchArrayElement());
+            Expression *element = matchArrayElement();
+            expressionStack_.push_back(element);
             token = &peekToken(1);
-            ExpectToken(*token, MakeTokenType(','), MakeTokenType('}'));
+            expectToken(*token, MakeTokenType(','), MakeTokenType('}'));
 
             if (token->type == MakeTokenType(',')) {
                 readToken();
@@ -926,6 +1065,7 @@ Parser::matchArrayLiteral()
     }
 
     readToken();
+    match->elements = popArray(&expressionStack_, expressionStackSize);
     return match;
 }
 
@@ -933,18 +1073,20 @@ Parser::matchArrayLiteral()
 const DictionaryLiteral *
 Parser::matchDictionaryLiteral()
 {
-    programData_->dictionaryLiterals.emplace_back();
-    DictionaryLiteral *match = &programData_->dictionaryLiterals.back();
+    DictionaryLiteral *match = &programData_->dictionaryLiterals.emplaceBack();
+    match->id = programData_->dictionaryLiterals.getSize() - 1;
     readToken();
-    ExpectToken(peekToken(1), MakeTokenType('{'));
+    expectToken(peekToken(1), MakeTokenType('{'));
     readToken();
     const Token *token = &peekToken(1);
+    std::size_t expressionPairStackSize = expressionPairStack_.size();
 
     if (token->type != MakeTokenType('}')) {
         for (;;) {
-            match->elements.push_back(matchDictionaryElement());
+            std::pair<Expression *, Expression *> element = matchDictionaryElement();
+            expressionPairStack_.push_back(element);
             token = &peekToken(1);
-            ExpectToken(*token, MakeTokenType(','), MakeTokenType('}'));
+            expectToken(*token, MakeTokenType(','), MakeTokenType('}'));
 
             if (token->type == MakeTokenType(',')) {
                 readToken();
@@ -960,6 +1102,7 @@ Parser::matchDictionaryLiteral()
     }
 
     readToken();
+    match->elements = popArray(&expressionPairStack_, expressionPairStackSize);
     return match;
 }
 
@@ -971,25 +1114,25 @@ Parser::matchFunctionLiteral()
         context_ = c;
     });
 
-    programData_->functionLiterals.emplace_back();
-    FunctionLiteral *match = &programData_->functionLiterals.back();
+    FunctionLiteral *match = &programData_->functionLiterals.emplaceBack();
+    match->id = programData_->functionLiterals.getSize() - 1;
     ParseContext context(context_, match);
     context_ = &context;
     scopeGuard.commit();
     readToken();
-    ExpectToken(peekToken(1), MakeTokenType('('));
+    expectToken(peekToken(1), MakeTokenType('('));
     readToken();
     const Token *token = &peekToken(1);
 
     if (token->type != MakeTokenType(')')) {
         for (;;) {
-            ExpectToken(*token, TokenType::AutoKeyword, MakeTokenType('.', '.', '.'));
+            expectToken(*token, TokenType::AutoKeyword, MakeTokenType('.', '.', '.'));
 
             if (token->type == TokenType::AutoKeyword) {
                 readToken();
                 match->parameters.push_back(getVariableName());
                 token = &peekToken(1);
-                ExpectToken(*token, MakeTokenType(','), MakeTokenType(')'));
+                expectToken(*token, MakeTokenType(','), MakeTokenType(')'));
 
                 if (token->type == MakeTokenType(',')) {
                     readToken();
@@ -1000,27 +1143,27 @@ Parser::matchFunctionLiteral()
             } else {
                 match->isVariadic = true;
                 readToken();
-                ExpectToken(peekToken(1), MakeTokenType(')'));
+                expectToken(peekToken(1), MakeTokenType(')'));
                 break;
             }
         }
     }
 
     readToken();
-    ExpectToken(peekToken(1), MakeTokenType('{'));
+    expectToken(peekToken(1), MakeTokenType('{'));
     readToken();
     matchStatements(&match->body, MakeTokenType('}'));
     return match;
 }
 
 
-std::unique_ptr<Expression>
+Expression *
 Parser::matchArrayElement()
 {
     const Token *token = &peekToken(1);
 
     if (token->type == MakeTokenType('.', '.', '.')) {
-        auto match = std::make_unique<PrimaryExpression>();
+        auto match = createNode<PrimaryExpression>();
         match->type = PrimaryExpressionType::Varargs;
         readToken();
         return match;
@@ -1030,59 +1173,102 @@ Parser::matchArrayElement()
 }
 
 
-std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>>
+std::pair<Expression *, Expression *>
 Parser::matchDictionaryElement()
 {
-    ExpectToken(peekToken(1), MakeTokenType('.'), MakeTokenType('['));
-    std::unique_ptr<Expression> key = matchElementSelector();
-    ExpectToken(peekToken(1), MakeTokenType('='));
+    expectToken(peekToken(1), MakeTokenType('.'), MakeTokenType('['));
+    Expression *key = matchElementSelector();
+    expectToken(peekToken(1), MakeTokenType('='));
     readToken();
-    return std::make_pair(std::move(key), matchExpression2());
+    return std::make_pair(key, matchExpression2());
 }
 
 
-const std::string *
+SymbolID
 Parser::getVariableName()
 {
-    ExpectToken(peekToken(1), TokenType::Identifier);
-    const std::string *variableName = getIdentifier();
+    expectToken(peekToken(1), TokenType::Identifier);
+    SymbolID variableName = getIdentifier();
     context_->addVariableName(variableName);
     return variableName;
 }
 
 
-const std::string *
+SymbolID
 Parser::findVariableName()
 {
     Token token = readToken();
-    const std::string *variableName = context_->searchVariableName(token.value);
+    SymbolID variableName = programData_->strings.intern(token.value);
 
-    if (variableName == nullptr) {
-        throw Error::UndeclaredVariable(token);
+    if (!context_->searchVariableName(variableName)) {
+        throw Error::UndeclaredVariable(locateToken(token));
     }
 
     return variableName;
 }
 
 
+void
+Parser::assignVariable(const Expression *lvalue)
+{
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(lvalue);
+
+    if (primaryExpression != nullptr
+        && primaryExpression->type == PrimaryExpressionType::VariableName) {
+        context_->assignVariableName(primaryExpression->string);
+    }
+
+    return;
+}
+
+
 ParseContext::ParseContext(ParseContext *super, FunctionLiteral *functionLiteral)
   : super_(super),
-    functionLiteral_(functionLiteral)
+    functionLiteral_(functionLiteral),
+    depth_(super == nullptr ? 0 : super->depth_ + 1),
+    symbolTable_(super == nullptr ? &ownSymbolTable_ : super->symbolTable_)
+{
+}
+
+
+ParseContext::~ParseContext()
 {
+    std::vector<VariableBinding> &bindings = symbolTable_->bindings;
+    int numberOfVariableNames = static_cast<int>(bindings.size());
+
+    while (numberOfVariableNames >= 1 && bindings[numberOfVariableNames - 1].depth == depth_) {
+        --numberOfVariableNames;
+    }
+
+    deleteVariableNames(numberOfVariableNames);
+
+    for (SymbolID superVariableName : functionLiteral_->superVariableNames) {
+        int bindingIndex = symbolTable_->symbolIDToBindingIndex[superVariableName];
+        bindings[bindingIndex].captureDepth = depth_ - 1;
+    }
 }
 
 
 int
 ParseContext::getNumberOfVariableNames() const
 {
-    return static_cast<int>(variableNames_.size());
+    return static_cast<int>(symbolTable_->bindings.size());
 }
 
 
 void
-ParseContext::addVariableName(const std::string *variableName)
+ParseContext::addVariableName(SymbolID variableName)
 {
-    variableNames_.push_back(variableName);
+    std::vector<VariableBinding> &bindings = symbolTable_->bindings;
+    std::vector<int> &symbolIDToBindingIndex = symbolTable_->symbolIDToBindingIndex;
+
+    if (variableName >= symbolIDToBindingIndex.size()) {
+        symbolIDToBindingIndex.resize(variableName + 1, -1);
+    }
+
+    bindings.push_back({variableName, depth_, depth_, symbolIDToBindingIndex[variableName], false
+                        , false});
+    symbolIDToBindingIndex[variableName] = static_cast<int>(bindings.size()) - 1;
     return;
 }
 
@@ -1090,51 +1276,70 @@ ParseContext::addVariableName(const std::string *variableName)
 void
 ParseContext::deleteVariableNames(int numberOfVariableNames)
 {
-    variableNames_.erase(variableNames_.begin() + numberOfVariableNames, variableNames_.end());
+    std::vector<VariableBinding> &bindings = symbolTable_->bindings;
+    std::vector<int> &symbolIDToBindingIndex = symbolTable_->symbolIDToBindingIndex;
+
+    while (static_cast<int>(bindings.size()) > numberOfVariableNames) {
+        const VariableBinding &binding = bindings.back();
+        symbolIDToBindingIndex[binding.name] = binding.previousBindingIndex;
+
+        if (binding.isCaptured && binding.isAssigned) {
+            std::vector<SymbolID> &cellVariableNames = functionLiteral_->cellVariableNames;
+
+            if (std::find(cellVariableNames.begin(), cellVariableNames.end(), binding.name)
+                == cellVariableNames.end()) {
+                cellVariableNames.push_back(binding.name);
+            }
+        }
+
+        bindings.pop_back();
+    }
+
     return;
 }
 
 
-const std::string *
-ParseContext::searchVariableName(const std::string &variableName)
+bool
+ParseContext::searchVariableName(SymbolID variableName)
 {
-    for (const std::string *x : variableNames_) {
-        if (*x == variableName) {
-            return x;
-        }
+    const std::vector<int> &symbolIDToBindingIndex = symbolTable_->symbolIDToBindingIndex;
+
+    if (variableName >= symbolIDToBindingIndex.size()) {
+        return false;
     }
 
-    if (super_ == nullptr) {
-        return nullptr;
-    } else {
-        const std::string *result = super_->searchVariableName(variableName);
+    int bindingIndex = symbolIDToBindingIndex[variableName];
 
-        if (result != nullptr) {
-            functionLiteral_->superVariableNames.push_back(result);
-            variableNames_.push_back(result);
-        }
+    if (bindingIndex < 0) {
+        return false;
+    }
 
-        return result;
+    VariableBinding *binding = &symbolTable_->bindings[bindingIndex];
+
+    if (binding->depth < depth_) {
+        binding->isCaptured = true;
     }
-}
 
+    if (binding->captureDepth < depth_) {
+        for (ParseContext *context = this; context->depth_ > binding->captureDepth
+             ; context = context->super_) {
+            context->functionLiteral_->superVariableNames.push_back(variableName);
+        }
 
-namespace {
+        binding->captureDepth = depth_;
+    }
 
-void
-SetStatementPosition(Statement *statement, const Token &token)
-{
-    statement->lineNumber = token.lineNumber;
-    statement->columnNumber = token.columnNumber;
-    return;
+    return true;
 }
 
 
 void
-ExpectToken(const Token &token, TokenType tokenType)
+ParseContext::initializeVariableName(SymbolID variableName)
 {
-    if (token.type != tokenType) {
-        throw Error::UnexpectedToken(token, tokenType);
+    VariableBinding *binding = getVariableBinding(variableName);
+
+    if (binding->isCaptured) {
+        binding->isAssigned = true;
     }
 
     return;
@@ -1142,18 +1347,24 @@ ExpectToken(const Token &token, TokenType tokenType)
 
 
 void
-ExpectToken(const Token &token, TokenType tokenType1, TokenType tokenType2)
+ParseContext::assignVariableName(SymbolID variableName)
 {
-    if (token.type != tokenType1 && token.type != tokenType2) {
-        throw Error::UnexpectedToken(token, tokenType1, tokenType2);
-    }
-
+    getVariableBinding(variableName)->isAssigned = true;
     return;
 }
 
 
+ParseContext::VariableBinding *
+ParseContext::getVariableBinding(SymbolID variableName)
+{
+    return &symbolTable_->bindings[symbolTable_->symbolIDToBindingIndex[variableName]];
+}
+
+
+namespace {
+
 void
-EvaluateStringLiteral(const std::string &stringLiteral, std::string *string)
+EvaluateStringLiteral(std::string_view stringLiteral, std::string *string)
 {
     const char *p = stringLiteral.data() + 1;
     unsigned char c = *p;
@@ -2,12 +2,12 @@
 
 
 #include <functional>
-#include <list>
-#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "Arena.h"
+#include "Statement.h"
 #include "Token.h"
 
 
@@ -15,14 +15,12 @@ namespace OYC {
 
 struct Program;
 struct ProgramData;
-struct Statement;
-struct VariableDeclarator;
-struct CaseClause;
 struct Expression;
 struct ArrayLiteral;
 struct DictionaryLiteral;
 struct FunctionLiteral;
 
+class Scanner;
 class ParseContext;
 
 
@@ -36,70 +34,98 @@ public:
 
     inline void setInput(const std::function<Token ()> &);
     inline void setInput(std::function<Token ()> &&);
+    inline void setInput(Scanner *);
+    inline void setTokenLocator(const std::function<void (Token *)> &);
+    inline void setTokenLocator(std::function<void (Token *)> &&);
 
     Program readProgram();
 
 private:
+    static constexpr int MaxNumberOfPrereadTokens = 4;
+
     std::function<Token ()> input_;
-    std::list<Token> prereadTokens_;
+    Scanner *scanner_;
+    std::function<void (Token *)> tokenLocator_;
+    Token prereadTokens_[MaxNumberOfPrereadTokens];
+    int firstPrereadTokenIndex_;
+    int numberOfPrereadTokens_;
 
     ProgramData *programData_;
     ParseContext *context_;
+    std::vector<Statement *> statementStack_;
+    std::vector<Expression *> expressionStack_;
+    std::vector<std::pair<Expression *, Expression *>> expressionPairStack_;
+    std::vector<VariableDeclarator> variableDeclaratorStack_;
+    std::vector<CaseClause> caseClauseStack_;
 
     Token doReadToken();
     const Token &peekToken(int);
     Token readToken();
+    Token locateToken(Token) const;
+    void setStatementPosition(Statement *, const Token &) const;
+    void expectToken(const Token &, TokenType) const;
+    void expectToken(const Token &, TokenType, TokenType) const;
+
+    template <class T>
+    T *createNode();
+
+    template <class T>
+    ArenaArray<T> popArray(std::vector<T> *, std::size_t);
 
     void matchProgramMain(FunctionLiteral *);
-    void matchStatements(std::vector<std::unique_ptr<Statement>> *, TokenType);
-
-    std::unique_ptr<Statement> matchStatement();
-    std::unique_ptr<Statement> matchExpressionStatement();
-    std::unique_ptr<Statement> matchAutoStatement();
-    std::unique_ptr<Statement> matchBreakStatement();
-    std::unique_ptr<Statement> matchContinueStatement();
-    std::unique_ptr<Statement> matchReturnStatement();
-    std::unique_ptr<Statement> matchIfStatement();
-    std::unique_ptr<Statement> matchSwitchStatement();
-    std::unique_ptr<Statement> matchWhileStatement();
-    std::unique_ptr<Statement> matchDoWhileStatement();
-    std::unique_ptr<Statement> matchForStatement();
-    std::unique_ptr<Statement> matchForeachStatement();
+    void matchStatements(ArenaArray<Statement *> *, TokenType);
+
+    Statement *matchStatement();
+    Statement *matchExpressionStatement();
+    Statement *matchAutoStatement();
+    Statement *matchBreakStatement();
+    Statement *matchContinueStatement();
+    Statement *matchReturnStatement();
+    Statement *matchIfStatement();
+    Statement *matchSwitchStatement();
+    Statement *matchWhileStatement();
+    Statement *matchDoWhileStatement();
+    Statement *matchForStatement();
+    Statement *matchForeachStatement();
 
     void matchVariableDeclarator(VariableDeclarator *);
-    void matchBlock(std::vector<std::unique_ptr<Statement>> *);
+    void matchBlock(ArenaArray<Statement *> *);
     void matchCaseClause(CaseClause *);
 
-    std::unique_ptr<Expression> matchExpression1();
-    std::unique_ptr<Expression> matchExpression2();
-    std::unique_ptr<Expression> matchExpression3(int *);
-    std::unique_ptr<Expression> matchExpression4();
-    std::unique_ptr<Expression> matchExpression5();
-    std::unique_ptr<Expression> matchExpression6();
-    std::unique_ptr<Expression> matchElementSelector();
+    Expression *matchExpression1();
+    Expression *matchExpression2();
+    Expression *matchExpression3(int *);
+    Expression *matchExpression4();
+    Expression *matchExpression5();
+    Expression *matchExpression6();
+    Expression *matchElementSelector();
 
     bool getBoolean();
     unsigned long getInteger();
     double getFloatingPoint();
-    const std::string *getString();
-    const std::string *getIdentifier();
+    SymbolID getString();
+    SymbolID getIdentifier();
 
     const ArrayLiteral *matchArrayLiteral();
     const DictionaryLiteral *matchDictionaryLiteral();
     const FunctionLiteral *matchFunctionLiteral();
 
-    std::unique_ptr<Expression> matchArrayElement();
-    std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> matchDictionaryElement();
+    Expression *matchArrayElement();
+    std::pair<Expression *, Expression *> matchDictionaryElement();
 
-    const std::string *getVariableName();
-    const std::string *findVariableName();
+    SymbolID getVariableName();
+    SymbolID findVariableName();
+    void assignVariable(const Expression *);
 };
 
 
 Parser::Parser()
   : input_([] () -> Token {
-        return {TokenType::EndOfFile, {}, 1, 1};
-    })
+        return {TokenType::EndOfFile, {}, 0, 1, 1};
+    }),
+    scanner_(nullptr),
+    firstPrereadTokenIndex_(0),
+    numberOfPrereadTokens_(0)
 {
 }
 
@@ -108,6 +134,7 @@ void
 Parser::setInput(const std::function<Token ()> &input)
 {
     input_ = input;
+    scanner_ = nullptr;
 }
 
 
@@ -115,6 +142,28 @@ void
 Parser::setInput(std::function<Token ()> &&input)
 {
     input_ = std::move(input);
+    scanner_ = nullptr;
+}
+
+
+void
+Parser::setInput(Scanner *scanner)
+{
+    scanner_ = scanner;
+}
+
+
+void
+Parser::setTokenLocator(const std::function<void (Token *)> &tokenLocator)
+{
+    tokenLocator_ = tokenLocator;
+}
+
+
+void
+Parser::setTokenLocator(std::function<void (Token *)> &&tokenLocator)
+{
+    tokenLocator_ = std::move(tokenLocator);
 }
 
 } // namespace OYC
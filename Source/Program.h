@@ -1,13 +1,13 @@
 #pragma once
 
 
-#include <list>
-#include <memory>
-#include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "Arena.h"
+#include "SegmentedVector.h"
+#include "StringInterner.h"
+
 
 namespace OYC {
 
@@ -17,31 +17,36 @@ struct Statement;
 
 struct ArrayLiteral
 {
-    std::vector<std::unique_ptr<Expression>> elements;
+    int id = -1;
+    ArenaArray<Expression *> elements;
 };
 
 
 struct DictionaryLiteral
 {
-    std::vector<std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>>> elements;
+    int id = -1;
+    ArenaArray<std::pair<Expression *, Expression *>> elements;
 };
 
 
 struct FunctionLiteral
 {
-    std::vector<const std::string *> parameters;
+    int id = -1;
+    std::vector<SymbolID> parameters;
     bool isVariadic = false;
-    std::vector<const std::string *> superVariableNames;
-    std::vector<std::unique_ptr<Statement>> body;
+    std::vector<SymbolID> superVariableNames;
+    std::vector<SymbolID> cellVariableNames;
+    ArenaArray<Statement *> body;
 };
 
 
 struct ProgramData
 {
-    std::unordered_set<std::string> strings;
-    std::list<ArrayLiteral> arrayLiterals;
-    std::list<DictionaryLiteral> dictionaryLiterals;
-    std::list<FunctionLiteral> functionLiterals;
+    Arena arena;
+    StringInterner strings;
+    SegmentedVector<ArrayLiteral> arrayLiterals;
+    SegmentedVector<DictionaryLiteral> dictionaryLiterals;
+    SegmentedVector<FunctionLiteral> functionLiterals;
 };
 
 
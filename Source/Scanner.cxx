@@ -1,11 +1,12 @@
 #include "Scanner.h"
 
+#include <algorithm>
 #include <cctype>
-#include <iterator>
-#include <type_traits>
-#include <unordered_map>
+#include <cstring>
 
+#include "CharSearch.h"
 #include "Error.h"
+#include "SourceFile.h"
 #include "Token.h"
 
 
@@ -13,17 +14,7 @@ namespace OYC {
 
 namespace {
 
-const auto KeywordToTokenType = [] () -> std::unordered_map<std::string, TokenType> {
-    std::unordered_map<std::string, TokenType> result;
-
-    for (auto k = static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordBegin)
-         ; k < static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordEnd); ++k) {
-        auto tokenType = static_cast<TokenType>(k);
-        result.emplace(TokenTypeToString(tokenType), tokenType);
-    }
-
-    return result;
-}();
+const std::size_t InputBlockSize = 4096;
 
 
 bool isodigit(int);
@@ -31,48 +22,146 @@ bool isodigit(int);
 } // namespace
 
 
+void
+Scanner::setInput(const SourceFile &sourceFile)
+{
+    setInput(sourceFile.getText());
+}
+
+
 Token
 Scanner::readToken()
 {
     Token token;
-    token.lineNumber = lineNumber_;
-    token.columnNumber = columnNumber_;
+    startToken(&token);
     matchToken(&token);
+    completeToken(&token);
     return token;
 }
 
 
-int
-Scanner::doReadChar()
+Token
+Scanner::readSignificantToken()
+{
+    Token token;
+
+    for (;;) {
+        startToken(&token);
+
+        switch (peekChar(1)) {
+            int c2;
+
+        case '\t':
+        case '\n':
+        case '\v':
+        case '\f':
+        case '\r':
+        case ' ':
+            matchWhiteSpaceToken(&token);
+            continue;
+
+        case '/':
+            c2 = peekChar(2);
+
+            if (c2 == '*' || c2 == '/') {
+                matchCommentToken(&token);
+                continue;
+            }
+
+            break;
+        }
+
+        break;
+    }
+
+    matchToken(&token);
+    completeToken(&token);
+    return token;
+}
+
+
+void
+Scanner::locateToken(Token *token)
 {
-    return input_();
+    if (!newlineIndexIsComplete_) {
+        newlineIndex_.addNewlines(inputBlock_, inputBlock_ + inputBlockSize_, 0);
+        newlineIndexIsComplete_ = true;
+    }
+
+    newlineIndex_.locate(token->offset, &token->lineNumber, &token->columnNumber);
+    return;
+}
+
+
+bool
+Scanner::fillInput(int numberOfChars)
+{
+    if (input_ == nullptr) {
+        return false;
+    }
+
+    if (static_cast<std::size_t>(inputPosition_ - inputBlock_) + numberOfChars > inputBlockSize_) {
+        std::size_t n = inputEnd_ - tokenStart_;
+        std::size_t blockSize = std::max(InputBlockSize, 2 * (n + numberOfChars));
+        std::unique_ptr<char []> block(new char[blockSize]);
+
+        if (n >= 1) {
+            std::memcpy(block.get(), tokenStart_, n);
+        }
+
+        inputBlockOffset_ += tokenStart_ - inputBlock_;
+        inputPosition_ = block.get() + (inputPosition_ - tokenStart_);
+        inputEnd_ = block.get() + n;
+        tokenStart_ = block.get();
+        inputBlock_ = block.get();
+        inputBlockSize_ = blockSize;
+        inputBlocks_.push_back(std::move(block));
+    }
+
+    char *blockEnd = inputBlocks_.back().get() + (inputEnd_ - inputBlock_);
+
+    while (blockEnd - inputPosition_ < numberOfChars) {
+        int c = input_();
+
+        if (c < 0) {
+            break;
+        }
+
+        if (c == '\n') {
+            newlineIndex_.addNewline(inputBlockOffset_ + (blockEnd - inputBlock_));
+        }
+
+        *blockEnd++ = c;
+    }
+
+    inputEnd_ = blockEnd;
+    return inputEnd_ - inputPosition_ >= numberOfChars;
 }
 
 
 int
 Scanner::peekChar(int position)
 {
-    for (int n = position - static_cast<int>(prereadChars_.size()); n >= 1; --n) {
-        prereadChars_.push_back(doReadChar());
+    if (inputEnd_ - inputPosition_ < position && !fillInput(position)) {
+        return -1;
     }
 
-    return *std::next(prereadChars_.begin(), position - 1);
+    return static_cast<unsigned char>(inputPosition_[position - 1]);
 }
 
 
 int
 Scanner::readChar()
 {
-    int c;
-
-    if (prereadChars_.empty()) {
-        c = doReadChar();
-    } else {
-        c = prereadChars_.front();
-        prereadChars_.pop_front();
-    }
+    int c = peekChar(1);
 
     if (c >= 0) {
+        ++inputPosition_;
+
+        if (lazyPositioning_) {
+            return c;
+        }
+
         if (c == '\n') {
             ++lineNumber_;
             columnNumber_ = 1;
@@ -85,6 +174,72 @@ Scanner::readChar()
 }
 
 
+void
+Scanner::skipChars(const char *last)
+{
+    if (lazyPositioning_) {
+        inputPosition_ = last;
+        return;
+    }
+
+    const char *first = inputPosition_;
+
+    for (const char *p = FindChar(first, last, '\n'); p < last; p = FindChar(p + 1, last, '\n')) {
+        ++lineNumber_;
+        columnNumber_ = 1;
+        first = p + 1;
+    }
+
+    columnNumber_ += last - first;
+    inputPosition_ = last;
+}
+
+
+void
+Scanner::skipLineChars(const char *last)
+{
+    if (!lazyPositioning_) {
+        columnNumber_ += last - inputPosition_;
+    }
+
+    inputPosition_ = last;
+}
+
+
+void
+Scanner::startToken(Token *token)
+{
+    tokenStart_ = inputPosition_;
+    token->offset = inputBlockOffset_ + (inputPosition_ - inputBlock_);
+
+    if (!lazyPositioning_) {
+        token->lineNumber = lineNumber_;
+        token->columnNumber = columnNumber_;
+    }
+
+    return;
+}
+
+
+const Token &
+Scanner::completeToken(Token *token) const
+{
+    token->value = std::string_view(tokenStart_, inputPosition_ - tokenStart_);
+    return *token;
+}
+
+
+const Token &
+Scanner::completeIllegalToken(Token *token)
+{
+    if (lazyPositioning_) {
+        locateToken(token);
+    }
+
+    return completeToken(token);
+}
+
+
 void
 Scanner::matchToken(Token *match)
 {
@@ -113,11 +268,11 @@ Scanner::matchToken(Token *match)
     case '^':
     case '|':
     case '=':
-        match->value += readChar();
+        readChar();
         c2 = peekChar(1);
 
         if (c2 == '=') {
-            match->value += readChar();
+            readChar();
             match->type = MakeTokenType(c1, c2);
             return;
         } else {
@@ -140,17 +295,17 @@ Scanner::matchToken(Token *match)
     case '{':
     case '}':
     case '~':
-        match->value += readChar();
+        readChar();
         match->type = MakeTokenType(c1);
         return;
 
     case '+':
     case '-':
-        match->value += readChar();
+        readChar();
         c2 = peekChar(1);
 
         if (c2 == c1 || c2 == '=') {
-            match->value += readChar();
+            readChar();
             match->type = MakeTokenType(c1, c2);
             return;
         } else {
@@ -165,11 +320,11 @@ Scanner::matchToken(Token *match)
             matchNumberLiteralToken(match);
             return;
         } else {
-            match->value += readChar();
+            readChar();
 
             if (c2 == '.' && (c3 = peekChar(2)) == '.') {
-                match->value += readChar();
-                match->value += readChar();
+                readChar();
+                readChar();
                 match->type = MakeTokenType(c1, c2, c3);
                 return;
             } else {
@@ -185,10 +340,10 @@ Scanner::matchToken(Token *match)
             matchCommentToken(match);
             return;
         } else {
-            match->value += readChar();
+            readChar();
 
             if (c2 == '=') {
-                match->value += readChar();
+                readChar();
                 match->type = MakeTokenType(c1, c2);
                 return;
             } else {
@@ -199,15 +354,15 @@ Scanner::matchToken(Token *match)
 
     case '<':
     case '>':
-        match->value += readChar();
+        readChar();
         c2 = peekChar(1);
 
         if (c2 == c1) {
-            match->value += readChar();
+            readChar();
             c3 = peekChar(1);
 
             if (c3 == '=') {
-                match->value += readChar();
+                readChar();
                 match->type = MakeTokenType(c1, c2, c3);
                 return;
             } else {
@@ -215,7 +370,7 @@ Scanner::matchToken(Token *match)
                 return;
             }
         } else if (c2 == '=') {
-            match->value += readChar();
+            readChar();
             match->type = MakeTokenType(c1, c2);
             return;
         } else {
@@ -267,7 +422,7 @@ Scanner::matchToken(Token *match)
         return;
 
     default:
-        throw Error::IllegalToken(*match);
+        throw Error::IllegalToken(completeIllegalToken(match));
     }
 }
 
@@ -275,13 +430,9 @@ Scanner::matchToken(Token *match)
 void
 Scanner::matchWhiteSpaceToken(Token *match)
 {
-    match->value += readChar();
-    int c = peekChar(1);
-
-    while (std::isspace(c)) {
-        match->value += readChar();
-        c = peekChar(1);
-    }
+    do {
+        skipChars(SkipWhiteSpaces(inputPosition_, inputEnd_));
+    } while (inputPosition_ == inputEnd_ && fillInput(1));
 
     match->type = TokenType::WhiteSpace;
     return;
@@ -291,40 +442,30 @@ Scanner::matchWhiteSpaceToken(Token *match)
 void
 Scanner::matchCommentToken(Token *match)
 {
-    match->value += readChar();
-    int c = peekChar(1);
+    readChar();
+    int c = readChar();
 
     if (c == '*') {
-        match->value += readChar();
-        c = peekChar(1);
-
         for (;;) {
-            if (c == '*') {
-                match->value += readChar();
-                c = peekChar(1);
+            skipChars(FindChar(inputPosition_, inputEnd_, '*'));
+            c = readChar();
 
-                if (c == '/') {
-                    match->value += readChar();
+            if (c == '*') {
+                if (peekChar(1) == '/') {
+                    readChar();
                     match->type = TokenType::Comment;
                     return;
                 }
             } else {
                 if (c < 0) {
-                    throw Error::IllegalToken(*match);
+                    throw Error::IllegalToken(completeIllegalToken(match));
                 }
-
-                match->value += readChar();
-                c = peekChar(1);
             }
         }
     } else {
-        match->value += readChar();
-        c = peekChar(1);
-
-        while (c >= 0 && c != '\n') {
-            match->value += readChar();
-            c = peekChar(1);
-        }
+        do {
+            skipLineChars(FindChar(inputPosition_, inputEnd_, '\n'));
+        } while (inputPosition_ == inputEnd_ && fillInput(1));
 
         match->type = TokenType::Comment;
         return;
@@ -351,7 +492,7 @@ Scanner::matchNumberLiteralToken10(Token *match)
     int c = peekChar(1);
 
     while (std::isdigit(c)) {
-        match->value += readChar();
+        readChar();
         c = peekChar(1);
     }
 
@@ -359,45 +500,45 @@ Scanner::matchNumberLiteralToken10(Token *match)
 
     if (c == '.') {
         floatingPointFlag = true;
-        match->value += readChar();
+        readChar();
         c = peekChar(1);
 
         while (std::isdigit(c)) {
-            match->value += readChar();
+            readChar();
             c = peekChar(1);
         }
     }
 
     if (c == 'E' || c == 'e') {
         floatingPointFlag = true;
-        match->value += readChar();
+        readChar();
         c = peekChar(1);
 
         if (c == '+' || c == '-') {
-            match->value += readChar();
+            readChar();
             c = peekChar(1);
         }
 
         if (!std::isdigit(c)) {
             if (c >= 0 && c != '\n') {
-                match->value += readChar();
+                readChar();
             }
 
-            throw Error::IllegalToken(*match);
+            throw Error::IllegalToken(completeIllegalToken(match));
         }
 
-        match->value += readChar();
+        readChar();
         c = peekChar(1);
 
         while (std::isdigit(c)) {
-            match->value += readChar();
+            readChar();
             c = peekChar(1);
         }
     }
 
     if (std::isalpha(c) || c == '_') {
-        match->value += readChar();
-        throw Error::IllegalToken(*match);
+        readChar();
+        throw Error::IllegalToken(completeIllegalToken(match));
     }
 
     match->type = floatingPointFlag ? TokenType::FloatingPointLiteral : TokenType::IntegerLiteral;
@@ -408,29 +549,29 @@ Scanner::matchNumberLiteralToken10(Token *match)
 void
 Scanner::matchNumberLiteralToken16(Token *match)
 {
-    match->value += readChar();
-    match->value += readChar();
+    readChar();
+    readChar();
     int c = peekChar(1);
 
     if (!std::isxdigit(c)) {
         if (c >= 0 && c != '\n') {
-            match->value += readChar();
+            readChar();
         }
 
-        throw Error::IllegalToken(*match);
+        throw Error::IllegalToken(completeIllegalToken(match));
     }
 
-    match->value += readChar();
+    readChar();
     c = peekChar(1);
 
     while (std::isxdigit(c)) {
-        match->value += readChar();
+        readChar();
         c = peekChar(1);
     }
 
     if (std::isalpha(c) || c == '_') {
-        match->value += readChar();
-        throw Error::IllegalToken(*match);
+        readChar();
+        throw Error::IllegalToken(completeIllegalToken(match));
     }
 
     match->type = TokenType::IntegerLiteral;
@@ -441,28 +582,28 @@ Scanner::matchNumberLiteralToken16(Token *match)
 void
 Scanner::matchStringLiteralToken(Token *match)
 {
-    match->value += readChar();
-    int c = peekChar(1);
+    readChar();
 
     for (;;) {
+        skipLineChars(FindStringLiteralDelimiter(inputPosition_, inputEnd_));
+        int c = peekChar(1);
+
         if (c == '\"') {
-            match->value += readChar();
+            readChar();
             match->type = TokenType::StringLiteral;
             return;
         } else {
             if (c == '\\') {
-                if (!matchEscapeChar(&match->value)) {
-                    throw Error::IllegalToken(*match);
+                if (!matchEscapeChar()) {
+                    throw Error::IllegalToken(completeIllegalToken(match));
                 }
             } else {
                 if (c < 0 || c == '\n') {
-                    throw Error::IllegalToken(*match);
+                    throw Error::IllegalToken(completeIllegalToken(match));
                 }
 
-                match->value += readChar();
+                readChar();
             }
-
-            c = peekChar(1);
         }
     }
 }
@@ -471,25 +612,21 @@ Scanner::matchStringLiteralToken(Token *match)
 void
 Scanner::matchNameToken(Token *match)
 {
-    match->value += readChar();
-    int c = peekChar(1);
+    readChar();
 
-    while (std::isalnum(c) || c == '_') {
-        match->value += readChar();
-        c = peekChar(1);
-    }
+    do {
+        skipLineChars(SkipNameChars(inputPosition_, inputEnd_));
+    } while (inputPosition_ == inputEnd_ && fillInput(1));
 
-    std::unordered_map<std::string, TokenType>::const_iterator it = KeywordToTokenType
-                                                                    .find(match->value);
-    match->type = it == KeywordToTokenType.end() ? TokenType::Identifier : it->second;
+    match->type = NameToTokenType(completeToken(match).value);
     return;
 }
 
 
 bool
-Scanner::matchEscapeChar(std::string *match)
+Scanner::matchEscapeChar()
 {
-    *match += readChar();
+    readChar();
     int c = peekChar(1);
 
     switch (c) {
@@ -504,7 +641,7 @@ Scanner::matchEscapeChar(std::string *match)
     case 'r':
     case 't':
     case 'v':
-        *match += readChar();
+        readChar();
         return true;
 
     case '0':
@@ -515,40 +652,40 @@ Scanner::matchEscapeChar(std::string *match)
     case '5':
     case '6':
     case '7':
-        *match += readChar();
+        readChar();
         c = peekChar(1);
 
         if (isodigit(c)) {
-            *match += readChar();
+            readChar();
             c = peekChar(1);
 
             if (isodigit(c)) {
-                *match += readChar();
+                readChar();
             }
         }
 
         return true;
 
     case 'x':
-        *match += readChar();
+        readChar();
         c = peekChar(1);
 
         if (!std::isxdigit(c)) {
             break;
         }
 
-        *match += readChar();
+        readChar();
         c = peekChar(1);
 
         if (std::isxdigit(c)) {
-            *match += readChar();
+            readChar();
         }
 
         return true;
     }
 
     if (c >= 0 && c != '\n') {
-        *match += readChar();
+        readChar();
     }
 
     return false;
@@ -1,13 +1,19 @@
 #pragma once
 
 
+#include <cstddef>
 #include <functional>
-#include <list>
+#include <memory>
+#include <string_view>
 #include <utility>
+#include <vector>
+
+#include "NewlineIndex.h"
 
 
 namespace OYC {
 
+class SourceFile;
 struct Token;
 
 
@@ -21,18 +27,38 @@ public:
 
     inline void setInput(const std::function<int ()> &);
     inline void setInput(std::function<int ()> &&);
+    inline void setInput(std::string_view);
+    void setInput(const SourceFile &);
+    inline void setLazyPositioning(bool) noexcept;
 
     Token readToken();
+    Token readSignificantToken();
+    void locateToken(Token *);
 
 private:
     std::function<int ()> input_;
-    std::list<int> prereadChars_;
+    std::vector<std::unique_ptr<char []>> inputBlocks_;
+    std::size_t inputBlockSize_;
+    std::size_t inputBlockOffset_;
+    const char *inputBlock_;
+    const char *inputPosition_;
+    const char *inputEnd_;
+    const char *tokenStart_;
+    bool lazyPositioning_;
+    NewlineIndex newlineIndex_;
+    bool newlineIndexIsComplete_;
     int lineNumber_;
     int columnNumber_;
 
-    int doReadChar();
+    inline void resetInput(const char *, std::size_t);
+    bool fillInput(int);
     int peekChar(int);
     int readChar();
+    void startToken(Token *);
+    void skipChars(const char *);
+    void skipLineChars(const char *);
+    const Token &completeToken(Token *) const;
+    const Token &completeIllegalToken(Token *);
 
     void matchToken(Token *);
     void matchWhiteSpaceToken(Token *);
@@ -43,14 +69,19 @@ private:
     void matchStringLiteralToken(Token *);
     void matchNameToken(Token *);
 
-    bool matchEscapeChar(std::string *);
+    bool matchEscapeChar();
 };
 
 
 Scanner::Scanner()
-  : input_([] () -> int {
-        return -1;
-    }),
+  : inputBlockSize_(0),
+    inputBlockOffset_(0),
+    inputBlock_(nullptr),
+    inputPosition_(nullptr),
+    inputEnd_(nullptr),
+    tokenStart_(nullptr),
+    lazyPositioning_(false),
+    newlineIndexIsComplete_(true),
     lineNumber_(1),
     columnNumber_(1)
 {
@@ -61,6 +92,7 @@ void
 Scanner::setInput(const std::function<int ()> &input)
 {
     input_ = input;
+    resetInput(nullptr, 0);
 }
 
 
@@ -68,6 +100,37 @@ void
 Scanner::setInput(std::function<int ()> &&input)
 {
     input_ = std::move(input);
+    resetInput(nullptr, 0);
+}
+
+
+void
+Scanner::setInput(std::string_view input)
+{
+    input_ = nullptr;
+    resetInput(input.data(), input.size());
+}
+
+
+void
+Scanner::setLazyPositioning(bool lazyPositioning) noexcept
+{
+    lazyPositioning_ = lazyPositioning;
+}
+
+
+void
+Scanner::resetInput(const char *input, std::size_t inputSize)
+{
+    inputBlocks_.clear();
+    inputBlockSize_ = inputSize;
+    inputBlockOffset_ = 0;
+    inputBlock_ = input;
+    inputPosition_ = input;
+    inputEnd_ = input + inputSize;
+    tokenStart_ = input;
+    newlineIndex_.clear();
+    newlineIndexIsComplete_ = input_ != nullptr;
 }
 
 } // namespace OYC
@@ -0,0 +1,125 @@
+#pragma once
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace OYC {
+
+template <class T>
+class SegmentedVector final
+{
+    SegmentedVector(const SegmentedVector &) = delete;
+    SegmentedVector &operator=(const SegmentedVector &) = delete;
+
+public:
+    inline explicit SegmentedVector() noexcept;
+    inline SegmentedVector(SegmentedVector &&) noexcept;
+    inline ~SegmentedVector();
+
+    inline bool isEmpty() const noexcept;
+    inline int getSize() const noexcept;
+    inline T &operator[](int) noexcept;
+    inline const T &operator[](int) const noexcept;
+
+    template <class ...U>
+    inline T &emplaceBack(U &&...);
+
+private:
+    static constexpr int SegmentLength = 32;
+
+    typedef std::aligned_storage_t<sizeof(T), alignof(T)> Slot;
+
+    std::vector<std::unique_ptr<Slot []>> segments_;
+    int size_;
+
+    inline T *getElement(int) const noexcept;
+};
+
+
+template <class T>
+SegmentedVector<T>::SegmentedVector() noexcept
+  : size_(0)
+{
+}
+
+
+template <class T>
+SegmentedVector<T>::SegmentedVector(SegmentedVector &&other) noexcept
+  : segments_(std::move(other.segments_)),
+    size_(other.size_)
+{
+    other.segments_.clear();
+    other.size_ = 0;
+}
+
+
+template <class T>
+SegmentedVector<T>::~SegmentedVector()
+{
+    for (int i = 0; i < size_; ++i) {
+        getElement(i)->~T();
+    }
+}
+
+
+template <class T>
+bool
+SegmentedVector<T>::isEmpty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <class T>
+int
+SegmentedVector<T>::getSize() const noexcept
+{
+    return size_;
+}
+
+
+template <class T>
+T &
+SegmentedVector<T>::operator[](int index) noexcept
+{
+    return *getElement(index);
+}
+
+
+template <class T>
+const T &
+SegmentedVector<T>::operator[](int index) const noexcept
+{
+    return *getElement(index);
+}
+
+
+template <class T>
+template <class ...U>
+T &
+SegmentedVector<T>::emplaceBack(U &&...argument)
+{
+    if (size_ == static_cast<int>(segments_.size()) * SegmentLength) {
+        segments_.emplace_back(new Slot[SegmentLength]);
+    }
+
+    T *element = new (getElement(size_)) T(std::forward<U>(argument)...);
+    ++size_;
+    return *element;
+}
+
+
+template <class T>
+T *
+SegmentedVector<T>::getElement(int index) const noexcept
+{
+    return reinterpret_cast<T *>(&segments_[index / SegmentLength][index % SegmentLength]);
+}
+
+} // namespace OYC
@@ -0,0 +1,94 @@
+#include "Shape.h"
+
+#include "Object.h"
+
+
+namespace OYC {
+
+namespace {
+
+std::string_view GetKeyString(Value);
+
+} // namespace
+
+
+Shape::Shape(Shape *parent, Value key)
+  : parent_(parent),
+    key_(key),
+    numberOfKeys_(parent->numberOfKeys_ + 1)
+{
+}
+
+
+const std::vector<Value> &
+Shape::getKeys() const
+{
+    if (static_cast<int>(keys_.size()) < numberOfKeys_) {
+        keys_.resize(numberOfKeys_);
+
+        for (const Shape *shape = this; shape->parent_ != nullptr; shape = shape->parent_) {
+            keys_[shape->numberOfKeys_ - 1] = shape->key_;
+        }
+    }
+
+    return keys_;
+}
+
+
+int
+Shape::findKey(Value key) const
+{
+    if (key.getType() != ValueType::String) {
+        return -1;
+    }
+
+    std::string_view keyString = GetKeyString(key);
+
+    if (numberOfKeys_ <= MaxNumberOfUnindexedKeys) {
+        for (const Shape *shape = this; shape->parent_ != nullptr; shape = shape->parent_) {
+            if (GetKeyString(shape->key_) == keyString) {
+                return shape->numberOfKeys_ - 1;
+            }
+        }
+
+        return -1;
+    }
+
+    if (keyIndexes_.empty()) {
+        const std::vector<Value> &keys = getKeys();
+        keyIndexes_.reserve(keys.size());
+
+        for (int i = 0; i < numberOfKeys_; ++i) {
+            keyIndexes_.emplace(GetKeyString(keys[i]), i);
+        }
+    }
+
+    auto it = keyIndexes_.find(keyString);
+    return it == keyIndexes_.end() ? -1 : it->second;
+}
+
+
+Shape *
+Shape::addKey(Value key)
+{
+    std::unique_ptr<Shape> &transition = transitions_[GetKeyString(key)];
+
+    if (transition == nullptr) {
+        transition.reset(new Shape(this, key));
+    }
+
+    return transition.get();
+}
+
+
+namespace {
+
+std::string_view
+GetKeyString(Value key)
+{
+    return key.getString()->getValue();
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,62 @@
+#pragma once
+
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Value.h"
+
+
+namespace OYC {
+
+class Shape final
+{
+    Shape(const Shape &) = delete;
+    Shape &operator=(const Shape &) = delete;
+
+public:
+    inline explicit Shape();
+
+    inline Shape *getParent() const noexcept;
+    inline int getNumberOfKeys() const noexcept;
+    const std::vector<Value> &getKeys() const;
+    int findKey(Value) const;
+    Shape *addKey(Value);
+
+private:
+    static constexpr int MaxNumberOfUnindexedKeys = 8;
+
+    Shape *const parent_;
+    const Value key_;
+    const int numberOfKeys_;
+    std::unordered_map<std::string_view, std::unique_ptr<Shape>> transitions_;
+    mutable std::vector<Value> keys_;
+    mutable std::unordered_map<std::string_view, int> keyIndexes_;
+
+    explicit Shape(Shape *, Value);
+};
+
+
+Shape::Shape()
+  : parent_(nullptr),
+    numberOfKeys_(0)
+{
+}
+
+
+Shape *
+Shape::getParent() const noexcept
+{
+    return parent_;
+}
+
+
+int
+Shape::getNumberOfKeys() const noexcept
+{
+    return numberOfKeys_;
+}
+
+} // namespace OYC
@@ -0,0 +1,125 @@
+#include "SourceFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+#include "ScopeGuard.h"
+
+
+namespace OYC {
+
+namespace {
+
+[[noreturn]] void ThrowSystemError(const char *);
+
+} // namespace
+
+
+SourceFile::SourceFile(const char *fileName)
+  : mapping_(MAP_FAILED),
+    mappingSize_(0)
+{
+    int fd;
+
+    do {
+        fd = open(fileName, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+
+    if (fd < 0) {
+        ThrowSystemError(fileName);
+    }
+
+    ScopeGuard scopeGuard([fd] () -> void {
+        close(fd);
+    });
+
+    scopeGuard.commit();
+    struct stat fileStatus;
+
+    if (fstat(fd, &fileStatus) < 0) {
+        ThrowSystemError(fileName);
+    }
+
+    if (S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0
+        && mapFile(fd, fileStatus.st_size)) {
+        return;
+    }
+
+    if (!readFile(fd, fileStatus.st_blksize > 0 ? fileStatus.st_blksize : BUFSIZ)) {
+        ThrowSystemError(fileName);
+    }
+}
+
+
+SourceFile::~SourceFile()
+{
+    if (mapping_ != MAP_FAILED) {
+        munmap(mapping_, mappingSize_);
+    }
+}
+
+
+bool
+SourceFile::mapFile(int fd, std::size_t fileSize)
+{
+    void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+    mapping_ = mapping;
+    mappingSize_ = fileSize;
+    text_ = std::string_view(static_cast<const char *>(mapping), fileSize);
+    return true;
+}
+
+
+bool
+SourceFile::readFile(int fd, std::size_t blockSize)
+{
+    std::size_t n = 0;
+
+    for (;;) {
+        buffer_.resize(n + blockSize);
+        ssize_t result = read(fd, &buffer_[n], blockSize);
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        if (result == 0) {
+            break;
+        }
+
+        n += result;
+    }
+
+    buffer_.resize(n);
+    text_ = buffer_;
+    return true;
+}
+
+
+namespace {
+
+void
+ThrowSystemError(const char *fileName)
+{
+    throw std::system_error(errno, std::generic_category(), fileName);
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,39 @@
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+namespace OYC {
+
+class SourceFile final
+{
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
+
+public:
+    explicit SourceFile(const char *);
+    ~SourceFile();
+
+    inline std::string_view getText() const noexcept;
+
+private:
+    void *mapping_;
+    std::size_t mappingSize_;
+    std::string buffer_;
+    std::string_view text_;
+
+    bool mapFile(int, std::size_t);
+    bool readFile(int, std::size_t);
+};
+
+
+std::string_view
+SourceFile::getText() const noexcept
+{
+    return text_;
+}
+
+} // namespace OYC
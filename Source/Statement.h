@@ -1,10 +1,8 @@
 #pragma once
 
 
-#include <list>
-#include <memory>
-#include <string>
-#include <vector>
+#include "Arena.h"
+#include "StringInterner.h"
 
 
 namespace OYC {
@@ -27,7 +25,7 @@ struct Statement
 
 struct ExpressionStatement : Statement
 {
-    std::unique_ptr<Expression> expression;
+    Expression *expression = nullptr;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -35,14 +33,14 @@ struct ExpressionStatement : Statement
 
 struct VariableDeclarator
 {
-    const std::string *name;
-    std::unique_ptr<Expression> initializer;
+    SymbolID name;
+    Expression *initializer = nullptr;
 };
 
 
 struct AutoStatement : Statement
 {
-    std::list<VariableDeclarator> variableDeclarators;
+    ArenaArray<VariableDeclarator> variableDeclarators;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -62,7 +60,7 @@ struct ContinueStatement : Statement
 
 struct ReturnStatement : Statement
 {
-    std::unique_ptr<Expression> result;
+    Expression *result = nullptr;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -70,9 +68,9 @@ struct ReturnStatement : Statement
 
 struct IfStatement : Statement
 {
-    std::unique_ptr<Expression> condition;
-    std::vector<std::unique_ptr<Statement>> thenBody;
-    std::vector<std::unique_ptr<Statement>> elseBody;
+    Expression *condition = nullptr;
+    ArenaArray<Statement *> thenBody;
+    ArenaArray<Statement *> elseBody;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -80,15 +78,15 @@ struct IfStatement : Statement
 
 struct CaseClause
 {
-    std::unique_ptr<Expression> rhs;
-    std::vector<std::unique_ptr<Statement>> body;
+    Expression *rhs = nullptr;
+    ArenaArray<Statement *> body;
 };
 
 
 struct SwitchStatement : Statement
 {
-    std::unique_ptr<Expression> lhs;
-    std::list<CaseClause> caseClauses;
+    Expression *lhs = nullptr;
+    ArenaArray<CaseClause> caseClauses;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -96,8 +94,8 @@ struct SwitchStatement : Statement
 
 struct WhileStatement : Statement
 {
-    std::unique_ptr<Expression> condition;
-    std::vector<std::unique_ptr<Statement>> body;
+    Expression *condition = nullptr;
+    ArenaArray<Statement *> body;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -105,8 +103,8 @@ struct WhileStatement : Statement
 
 struct DoWhileStatement : Statement
 {
-    std::unique_ptr<Expression> condition;
-    std::vector<std::unique_ptr<Statement>> body;
+    Expression *condition = nullptr;
+    ArenaArray<Statement *> body;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -114,10 +112,10 @@ struct DoWhileStatement : Statement
 
 struct ForStatement : Statement
 {
-    std::unique_ptr<Statement> initialization;
-    std::unique_ptr<Expression> condition;
-    std::unique_ptr<Expression> iteration;
-    std::vector<std::unique_ptr<Statement>> body;
+    Statement *initialization = nullptr;
+    Expression *condition = nullptr;
+    Expression *iteration = nullptr;
+    ArenaArray<Statement *> body;
 
     void acceptVisit(StatementVisitor *) const override;
 };
@@ -125,10 +123,10 @@ struct ForStatement : Statement
 
 struct ForeachStatement : Statement
 {
-    const std::string *variableName1;
-    const std::string *variableName2;
-    std::unique_ptr<Expression> collection;
-    std::vector<std::unique_ptr<Statement>> body;
+    SymbolID variableName1;
+    SymbolID variableName2;
+    Expression *collection = nullptr;
+    ArenaArray<Statement *> body;
 
     void acceptVisit(StatementVisitor *) const override;
 };
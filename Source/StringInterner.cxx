@@ -0,0 +1,109 @@
+#include "StringInterner.h"
+
+#include <cstring>
+
+
+namespace OYC {
+
+namespace {
+
+const std::size_t MinNumberOfSlots = 64;
+
+
+std::uint32_t HashString(std::string_view);
+
+} // namespace
+
+
+SymbolID
+StringInterner::intern(std::string_view string)
+{
+    if (2 * symbolIDToString_.size() >= slots_.size()) {
+        expand();
+    }
+
+    std::uint32_t hash = HashString(string);
+    std::size_t slotIndexMask = slots_.size() - 1;
+    std::size_t slotIndex = hash & slotIndexMask;
+
+    for (;; slotIndex = (slotIndex + 1) & slotIndexMask) {
+        const Slot &slot = slots_[slotIndex];
+
+        if (slot.symbolID == NoSymbolID) {
+            break;
+        }
+
+        if (slot.hash == hash && symbolIDToString_[slot.symbolID] == string) {
+            return slot.symbolID;
+        }
+    }
+
+    char *stringCopy = nullptr;
+
+    if (!string.empty()) {
+        stringCopy = static_cast<char *>(arena_.allocate(string.size(), 1));
+        std::memcpy(stringCopy, string.data(), string.size());
+    }
+
+    auto symbolID = static_cast<SymbolID>(symbolIDToString_.size());
+    symbolIDToString_.emplace_back(stringCopy, string.size());
+    slots_[slotIndex] = {hash, symbolID};
+    return symbolID;
+}
+
+
+void
+StringInterner::expand()
+{
+    std::vector<Slot> slots(slots_.empty() ? MinNumberOfSlots : 2 * slots_.size(), Slot{0, NoSymbolID});
+    std::size_t slotIndexMask = slots.size() - 1;
+
+    for (const Slot &slot : slots_) {
+        if (slot.symbolID == NoSymbolID) {
+            continue;
+        }
+
+        std::size_t slotIndex = slot.hash & slotIndexMask;
+
+        while (slots[slotIndex].symbolID != NoSymbolID) {
+            slotIndex = (slotIndex + 1) & slotIndexMask;
+        }
+
+        slots[slotIndex] = slot;
+    }
+
+    slots_.swap(slots);
+    return;
+}
+
+
+namespace {
+
+std::uint32_t
+HashString(std::string_view string)
+{
+    const char *p = string.data();
+    std::size_t n = string.size();
+    std::uint64_t hash = UINT64_C(0x9E3779B97F4A7C15) ^ n;
+
+    for (; n >= 8; p += 8, n -= 8) {
+        std::uint64_t k;
+        std::memcpy(&k, p, 8);
+        hash = (hash ^ k) * UINT64_C(0xBF58476D1CE4E5B9);
+        hash ^= hash >> 31;
+    }
+
+    if (n >= 1) {
+        std::uint64_t k = 0;
+        std::memcpy(&k, p, n);
+        hash = (hash ^ k) * UINT64_C(0xBF58476D1CE4E5B9);
+        hash ^= hash >> 31;
+    }
+
+    hash *= UINT64_C(0x94D049BB133111EB);
+    return static_cast<std::uint32_t>(hash >> 32);
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,65 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Arena.h"
+
+
+namespace OYC {
+
+typedef std::uint32_t SymbolID;
+
+constexpr SymbolID NoSymbolID = 0;
+
+
+class StringInterner final
+{
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+public:
+    inline explicit StringInterner();
+    StringInterner(StringInterner &&) = default;
+
+    SymbolID intern(std::string_view);
+    inline std::string_view getString(SymbolID) const noexcept;
+    inline int getNumberOfSymbols() const noexcept;
+
+private:
+    struct Slot
+    {
+        std::uint32_t hash;
+        SymbolID symbolID;
+    };
+
+    Arena arena_;
+    std::vector<std::string_view> symbolIDToString_;
+    std::vector<Slot> slots_;
+
+    void expand();
+};
+
+
+StringInterner::StringInterner()
+  : symbolIDToString_(1)
+{
+}
+
+
+std::string_view
+StringInterner::getString(SymbolID symbolID) const noexcept
+{
+    return symbolIDToString_[symbolID];
+}
+
+
+int
+StringInterner::getNumberOfSymbols() const noexcept
+{
+    return static_cast<int>(symbolIDToString_.size());
+}
+
+} // namespace OYC
@@ -1,11 +1,15 @@
 #include "Token.h"
 
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
 
 namespace OYC {
 
 namespace {
 
-const char *PredefinedTokenTypeToString[] = {
+constexpr const char *PredefinedTokenTypeToString[] = {
     nullptr,
     "end-of-file",
     "white space",
@@ -40,6 +44,74 @@ const char *PredefinedTokenTypeToString[] = {
     "this"
 };
 
+
+const int NumberOfKeywords = static_cast<int>(TokenType::KeywordEnd)
+                             - static_cast<int>(TokenType::KeywordBegin);
+const std::size_t MaxKeywordLength = 8;
+
+
+constexpr bool
+KeywordsFitKeywordTable()
+{
+    for (int i = static_cast<int>(TokenType::KeywordBegin)
+         ; i < static_cast<int>(TokenType::KeywordEnd); ++i) {
+        const char *keyword = PredefinedTokenTypeToString[i];
+        std::size_t length = 0;
+
+        while (keyword[length] != '\0') {
+            ++length;
+        }
+
+        if (length == 0 || length > MaxKeywordLength || keyword[0] < 'a' || keyword[0] > 'z') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static_assert(std::size(PredefinedTokenTypeToString)
+              == static_cast<std::size_t>(TokenType::KeywordEnd), "missing token type strings");
+static_assert(KeywordsFitKeywordTable(), "keywords must be 1 to MaxKeywordLength lowercase chars");
+
+
+struct KeywordTable
+{
+    const char *keywords[NumberOfKeywords];
+    TokenType tokenTypes[NumberOfKeywords];
+    std::uint8_t bucketBegins[MaxKeywordLength + 1][26];
+    std::uint8_t bucketEnds[MaxKeywordLength + 1][26];
+};
+
+
+const auto Keywords = [] () -> KeywordTable {
+    KeywordTable result = {};
+    int n = 0;
+
+    for (std::size_t length = 1; length <= MaxKeywordLength; ++length) {
+        for (int c = 'a'; c <= 'z'; ++c) {
+            result.bucketBegins[length][c - 'a'] = n;
+
+            for (auto k = static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordBegin)
+                 ; k < static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordEnd); ++k) {
+                auto tokenType = static_cast<TokenType>(k);
+                const char *keyword = TokenTypeToString(tokenType);
+
+                if (std::strlen(keyword) == length && keyword[0] == c) {
+                    result.keywords[n] = keyword;
+                    result.tokenTypes[n] = tokenType;
+                    ++n;
+                }
+            }
+
+            result.bucketEnds[length][c - 'a'] = n;
+        }
+    }
+
+    return result;
+}();
+
 } // namespace
 
 
@@ -60,4 +132,24 @@ TokenTypeToString(TokenType tokenType)
     }
 }
 
+
+TokenType
+NameToTokenType(std::string_view name)
+{
+    if (name.empty() || name.size() > MaxKeywordLength || name[0] < 'a' || name[0] > 'z') {
+        return TokenType::Identifier;
+    }
+
+    int i = Keywords.bucketBegins[name.size()][name[0] - 'a'];
+    int j = Keywords.bucketEnds[name.size()][name[0] - 'a'];
+
+    for (; i < j; ++i) {
+        if (std::memcmp(Keywords.keywords[i] + 1, name.data() + 1, name.size() - 1) == 0) {
+            return Keywords.tokenTypes[i];
+        }
+    }
+
+    return TokenType::Identifier;
+}
+
 } // namespace OYC
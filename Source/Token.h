@@ -1,8 +1,9 @@
 #pragma once
 
 
+#include <cstddef>
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 
 namespace OYC {
@@ -53,7 +54,8 @@ enum class TokenType : std::uint32_t
 struct Token
 {
     TokenType type = TokenType::No;
-    std::string value;
+    std::string_view value;
+    std::size_t offset = 0;
     int lineNumber = 0;
     int columnNumber = 0;
 };
@@ -63,6 +65,7 @@ constexpr TokenType MakeTokenType(char, char = '\0', char = '\0');
 constexpr bool TokenTypeIsAbstract(TokenType);
 
 const char *TokenTypeToString(TokenType);
+TokenType NameToTokenType(std::string_view);
 
 
 constexpr TokenType
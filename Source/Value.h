@@ -0,0 +1,224 @@
+#pragma once
+
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace OYC {
+
+struct Object;
+struct BoxedInteger;
+struct String;
+struct Array;
+struct Dictionary;
+struct Closure;
+struct Cell;
+
+
+enum class ValueType : std::uint8_t
+{
+    Null = 0,
+    Boolean,
+    Integer,
+    FloatingPoint,
+    String,
+    Array,
+    Dictionary,
+    Closure
+};
+
+
+class Value final
+{
+public:
+    inline explicit Value() noexcept;
+
+    static inline bool IsSmallInteger(std::int64_t) noexcept;
+    static inline Value MakeBoolean(bool) noexcept;
+    static inline Value MakeSmallInteger(std::int64_t) noexcept;
+    static inline Value MakeFloatingPoint(double) noexcept;
+    static inline Value MakeObject(ValueType, Object *) noexcept;
+    static inline Value MakeCell(Cell *) noexcept;
+
+    inline ValueType getType() const noexcept;
+    inline bool isNull() const noexcept;
+    inline bool isSmallInteger() const noexcept;
+    inline bool isObject() const noexcept;
+    inline bool getBoolean() const noexcept;
+    inline std::int64_t getSmallInteger() const noexcept;
+    inline std::int64_t getInteger() const noexcept;
+    inline double getFloatingPoint() const noexcept;
+    inline Object *getObject() const noexcept;
+    inline BoxedInteger *getBoxedInteger() const noexcept;
+    inline String *getString() const noexcept;
+    inline Array *getArray() const noexcept;
+    inline Dictionary *getDictionary() const noexcept;
+    inline Closure *getClosure() const noexcept;
+    inline Cell *getCell() const noexcept;
+
+private:
+    static constexpr std::uint64_t BoxBits = UINT64_C(0xFFF8000000000000);
+    static constexpr std::uint64_t CanonicalNaNBits = UINT64_C(0x7FF8000000000000);
+    static constexpr int TagShift = 48;
+    static constexpr std::uint64_t PayloadMask = (UINT64_C(1) << TagShift) - 1;
+    static constexpr std::uint64_t BoxedIntegerTag
+        = static_cast<std::uint64_t>(ValueType::FloatingPoint);
+    // Cells only ever live in registers and upvalues, so they can share a tag.
+    static constexpr std::uint64_t CellTag = BoxedIntegerTag;
+
+    std::uint64_t bits_;
+
+    static inline constexpr std::uint64_t MakeBits(std::uint64_t, std::uint64_t) noexcept;
+
+    inline std::uint64_t getTag() const noexcept;
+};
+
+static_assert(sizeof(void *) == 8);
+static_assert(sizeof(Value) == 8);
+
+
+Value::Value() noexcept
+  : bits_(MakeBits(static_cast<std::uint64_t>(ValueType::Null), 0))
+{
+}
+
+
+bool
+Value::IsSmallInteger(std::int64_t integer) noexcept
+{
+    return integer >= -(INT64_C(1) << (TagShift - 1)) && integer < INT64_C(1) << (TagShift - 1);
+}
+
+
+Value
+Value::MakeBoolean(bool boolean) noexcept
+{
+    Value value;
+    value.bits_ = MakeBits(static_cast<std::uint64_t>(ValueType::Boolean), boolean);
+    return value;
+}
+
+
+Value
+Value::MakeSmallInteger(std::int64_t integer) noexcept
+{
+    Value value;
+    value.bits_ = MakeBits(static_cast<std::uint64_t>(ValueType::Integer)
+                           , static_cast<std::uint64_t>(integer));
+    return value;
+}
+
+
+Value
+Value::MakeFloatingPoint(double floatingPoint) noexcept
+{
+    Value value;
+
+    if (floatingPoint == floatingPoint) {
+        std::memcpy(&value.bits_, &floatingPoint, sizeof value.bits_);
+    } else {
+        value.bits_ = CanonicalNaNBits;
+    }
+
+    return value;
+}
+
+
+Value
+Value::MakeObject(ValueType type, Object *object) noexcept
+{
+    Value value;
+    value.bits_ = MakeBits(type == ValueType::Integer ? BoxedIntegerTag
+                                                      : static_cast<std::uint64_t>(type)
+                           , reinterpret_cast<std::uintptr_t>(object));
+    return value;
+}
+
+
+Value
+Value::MakeCell(Cell *cell) noexcept
+{
+    Value value;
+    value.bits_ = MakeBits(CellTag, reinterpret_cast<std::uintptr_t>(cell));
+    return value;
+}
+
+
+ValueType
+Value::getType() const noexcept
+{
+    if (bits_ < BoxBits) {
+        return ValueType::FloatingPoint;
+    }
+
+    std::uint64_t tag = getTag();
+    return tag == BoxedIntegerTag ? ValueType::Integer : static_cast<ValueType>(tag);
+}
+
+
+bool
+Value::isNull() const noexcept
+{
+    return bits_ == MakeBits(static_cast<std::uint64_t>(ValueType::Null), 0);
+}
+
+
+bool
+Value::isSmallInteger() const noexcept
+{
+    return (bits_ & ~PayloadMask) == MakeBits(static_cast<std::uint64_t>(ValueType::Integer), 0);
+}
+
+
+bool
+Value::isObject() const noexcept
+{
+    return bits_ >= MakeBits(BoxedIntegerTag, 0);
+}
+
+
+bool
+Value::getBoolean() const noexcept
+{
+    return (bits_ & 1) != 0;
+}
+
+
+std::int64_t
+Value::getSmallInteger() const noexcept
+{
+    return static_cast<std::int64_t>(bits_ << (64 - TagShift)) >> (64 - TagShift);
+}
+
+
+double
+Value::getFloatingPoint() const noexcept
+{
+    double floatingPoint;
+    std::memcpy(&floatingPoint, &bits_, sizeof floatingPoint);
+    return floatingPoint;
+}
+
+
+Object *
+Value::getObject() const noexcept
+{
+    return reinterpret_cast<Object *>(static_cast<std::uintptr_t>(bits_ & PayloadMask));
+}
+
+
+constexpr std::uint64_t
+Value::MakeBits(std::uint64_t tag, std::uint64_t payload) noexcept
+{
+    return BoxBits | tag << TagShift | (payload & PayloadMask);
+}
+
+
+std::uint64_t
+Value::getTag() const noexcept
+{
+    return (bits_ >> TagShift) & 7;
+}
+
+} // namespace OYC
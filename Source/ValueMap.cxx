@@ -0,0 +1,280 @@
+#include "ValueMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#   define OYC_VALUE_MAP_SSE2
+#   include <emmintrin.h>
+#endif
+
+#include "Object.h"
+
+
+namespace OYC {
+
+namespace {
+
+const std::size_t MinNumberOfSlots = 16;
+const std::size_t MaxNumberOfSlots = std::size_t(1) << 32;
+const std::uint8_t EmptyControl = 0x80;
+
+
+std::size_t GetMaxNumberOfEntries(std::size_t) noexcept;
+std::size_t GetHomeSlotIndex(std::size_t, std::size_t) noexcept;
+std::uint8_t GetControl(std::size_t) noexcept;
+unsigned int MatchControls(const std::uint8_t *, std::uint8_t) noexcept;
+unsigned int MatchEmptyControls(const std::uint8_t *) noexcept;
+
+} // namespace
+
+
+Value
+ValueMap::get(Value key) const
+{
+    std::size_t slotIndex;
+
+    if (size_ == 0 || !findSlot(key, HashValue(key), &slotIndex)) {
+        return Value();
+    }
+
+    return entries_[slots_[slotIndex]].value;
+}
+
+
+void
+ValueMap::set(Value key, Value value)
+{
+    std::size_t hash = HashValue(key);
+    std::size_t slotIndex;
+
+    if (!slots_.empty() && findSlot(key, hash, &slotIndex)) {
+        entries_[slots_[slotIndex]].value = value;
+        return;
+    }
+
+    if (entries_.size() == GetMaxNumberOfEntries(slots_.size())) {
+        std::size_t numberOfSlots = std::max(slots_.size(), MinNumberOfSlots);
+
+        if (2 * size_ >= GetMaxNumberOfEntries(numberOfSlots)) {
+            numberOfSlots *= 2;
+        }
+
+        rehash(numberOfSlots);
+        slotIndex = findEmptySlot(hash);
+    }
+
+    setControl(slotIndex, GetControl(hash));
+    slots_[slotIndex] = static_cast<std::uint32_t>(entries_.size());
+    entries_.push_back({hash, key, value});
+    ++size_;
+    return;
+}
+
+
+bool
+ValueMap::erase(Value key)
+{
+    std::size_t slotIndex;
+
+    if (size_ == 0 || !findSlot(key, HashValue(key), &slotIndex)) {
+        return false;
+    }
+
+    Entry &entry = entries_[slots_[slotIndex]];
+    entry.key = Value();
+    entry.value = Value();
+    --size_;
+    std::size_t slotIndexMask = slots_.size() - 1;
+
+    for (std::size_t nextSlotIndex = (slotIndex + 1) & slotIndexMask
+         ; controls_[nextSlotIndex] != EmptyControl
+         ; nextSlotIndex = (nextSlotIndex + 1) & slotIndexMask) {
+        std::size_t homeSlotIndex = GetHomeSlotIndex(entries_[slots_[nextSlotIndex]].hash
+                                                     , slotIndexMask);
+
+        if (((nextSlotIndex - homeSlotIndex) & slotIndexMask)
+            >= ((nextSlotIndex - slotIndex) & slotIndexMask)) {
+            setControl(slotIndex, controls_[nextSlotIndex]);
+            slots_[slotIndex] = slots_[nextSlotIndex];
+            slotIndex = nextSlotIndex;
+        }
+    }
+
+    setControl(slotIndex, EmptyControl);
+
+    while (!entries_.empty() && entries_.back().value.isNull()) {
+        entries_.pop_back();
+    }
+
+    return true;
+}
+
+
+void
+ValueMap::reserve(std::size_t numberOfEntries)
+{
+    std::size_t numberOfSlots = MinNumberOfSlots;
+
+    while (GetMaxNumberOfEntries(numberOfSlots) < numberOfEntries) {
+        numberOfSlots *= 2;
+    }
+
+    if (numberOfSlots > slots_.size()) {
+        rehash(numberOfSlots);
+    }
+
+    return;
+}
+
+
+bool
+ValueMap::findSlot(Value key, std::size_t hash, std::size_t *slotIndex) const
+{
+    std::size_t slotIndexMask = slots_.size() - 1;
+    std::uint8_t control = GetControl(hash);
+
+    for (std::size_t groupSlotIndex = GetHomeSlotIndex(hash, slotIndexMask);
+         ; groupSlotIndex = (groupSlotIndex + GroupSize) & slotIndexMask) {
+        const std::uint8_t *controls = &controls_[groupSlotIndex];
+        unsigned int emptyMatches = MatchEmptyControls(controls);
+        unsigned int matches = MatchControls(controls, control);
+
+        if (emptyMatches != 0) {
+            matches &= (emptyMatches & -emptyMatches) - 1;
+        }
+
+        for (; matches != 0; matches &= matches - 1) {
+            std::size_t matchedSlotIndex = (groupSlotIndex + __builtin_ctz(matches))
+                                           & slotIndexMask;
+            const Entry &entry = entries_[slots_[matchedSlotIndex]];
+
+            if (entry.hash == hash && ValuesAreEqual(entry.key, key)) {
+                *slotIndex = matchedSlotIndex;
+                return true;
+            }
+        }
+
+        if (emptyMatches != 0) {
+            *slotIndex = (groupSlotIndex + __builtin_ctz(emptyMatches)) & slotIndexMask;
+            return false;
+        }
+    }
+}
+
+
+std::size_t
+ValueMap::findEmptySlot(std::size_t hash) const noexcept
+{
+    std::size_t slotIndexMask = slots_.size() - 1;
+
+    for (std::size_t groupSlotIndex = GetHomeSlotIndex(hash, slotIndexMask);
+         ; groupSlotIndex = (groupSlotIndex + GroupSize) & slotIndexMask) {
+        unsigned int emptyMatches = MatchEmptyControls(&controls_[groupSlotIndex]);
+
+        if (emptyMatches != 0) {
+            return (groupSlotIndex + __builtin_ctz(emptyMatches)) & slotIndexMask;
+        }
+    }
+}
+
+
+void
+ValueMap::setControl(std::size_t slotIndex, std::uint8_t control) noexcept
+{
+    controls_[slotIndex] = control;
+
+    if (slotIndex < GroupSize - 1) {
+        controls_[slots_.size() + slotIndex] = control;
+    }
+
+    return;
+}
+
+
+void
+ValueMap::rehash(std::size_t numberOfSlots)
+{
+    if (numberOfSlots > MaxNumberOfSlots) {
+        throw std::length_error("too many dictionary elements");
+    }
+
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [] (const Entry &entry) {
+        return entry.value.isNull();
+    }), entries_.end());
+
+    entries_.reserve(GetMaxNumberOfEntries(numberOfSlots));
+    controls_.assign(numberOfSlots + GroupSize - 1, EmptyControl);
+    slots_.assign(numberOfSlots, 0);
+
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        std::size_t slotIndex = findEmptySlot(entries_[i].hash);
+        setControl(slotIndex, GetControl(entries_[i].hash));
+        slots_[slotIndex] = static_cast<std::uint32_t>(i);
+    }
+
+    return;
+}
+
+
+namespace {
+
+std::size_t
+GetMaxNumberOfEntries(std::size_t numberOfSlots) noexcept
+{
+    return numberOfSlots - numberOfSlots / 8;
+}
+
+
+std::size_t
+GetHomeSlotIndex(std::size_t hash, std::size_t slotIndexMask) noexcept
+{
+    return (hash >> 7) & slotIndexMask;
+}
+
+
+std::uint8_t
+GetControl(std::size_t hash) noexcept
+{
+    return hash & 0x7F;
+}
+
+
+#ifdef OYC_VALUE_MAP_SSE2
+unsigned int
+MatchControls(const std::uint8_t *controls, std::uint8_t control) noexcept
+{
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(controls));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(control))));
+}
+
+
+unsigned int
+MatchEmptyControls(const std::uint8_t *controls) noexcept
+{
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(controls)));
+}
+#else
+unsigned int
+MatchControls(const std::uint8_t *controls, std::uint8_t control) noexcept
+{
+    unsigned int matches = 0;
+
+    for (int i = 0; i < 16; ++i) {
+        matches |= unsigned(controls[i] == control) << i;
+    }
+
+    return matches;
+}
+
+
+unsigned int
+MatchEmptyControls(const std::uint8_t *controls) noexcept
+{
+    return MatchControls(controls, EmptyControl);
+}
+#endif
+
+} // namespace
+
+} // namespace OYC
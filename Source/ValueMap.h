@@ -0,0 +1,82 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Value.h"
+
+
+namespace OYC {
+
+class ValueMap final
+{
+    ValueMap(const ValueMap &) = delete;
+    ValueMap &operator=(const ValueMap &) = delete;
+
+public:
+    struct Entry
+    {
+        std::size_t hash;
+        Value key;
+        Value value;
+    };
+
+    inline explicit ValueMap();
+
+    inline std::size_t getSize() const noexcept;
+    inline std::size_t getNumberOfEntries() const noexcept;
+    inline const Entry &getEntry(std::size_t) const noexcept;
+    Value get(Value) const;
+    void set(Value, Value);
+    bool erase(Value);
+    void reserve(std::size_t);
+
+private:
+    static constexpr std::size_t GroupSize = 16;
+
+    // Entries are kept in insertion order. Erased entries are left in place with a null value
+    // until the next rehash, and the slots are backward-shifted so probing never sees them.
+    // A rehash compacts the erased entries away, so entry indexes are only stable between
+    // rehashes: foreach walks entries by index, and a set() of a new key inside the loop body can
+    // trigger a rehash that makes the loop skip entries that have not been visited yet.
+    std::vector<Entry> entries_;
+    std::vector<std::uint8_t> controls_;
+    std::vector<std::uint32_t> slots_;
+    std::size_t size_;
+
+    bool findSlot(Value, std::size_t, std::size_t *) const;
+    std::size_t findEmptySlot(std::size_t) const noexcept;
+    void setControl(std::size_t, std::uint8_t) noexcept;
+    void rehash(std::size_t);
+};
+
+
+ValueMap::ValueMap()
+  : size_(0)
+{
+}
+
+
+std::size_t
+ValueMap::getSize() const noexcept
+{
+    return size_;
+}
+
+
+std::size_t
+ValueMap::getNumberOfEntries() const noexcept
+{
+    return entries_.size();
+}
+
+
+const ValueMap::Entry &
+ValueMap::getEntry(std::size_t entryIndex) const noexcept
+{
+    return entries_[entryIndex];
+}
+
+} // namespace OYC
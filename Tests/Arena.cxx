@@ -0,0 +1,88 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+struct alignas(32) Wide
+{
+    char bytes[40];
+};
+
+
+void TestAllocation();
+void TestArrays();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestAllocation();
+    OYC::TestArrays();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+void
+TestAllocation()
+{
+    Arena arena;
+    std::vector<int *> integers;
+    bool pointersAreAligned = true;
+
+    for (int i = 0; i < 100000; ++i) {
+        integers.push_back(arena.create<int>(i));
+        auto x = reinterpret_cast<std::uintptr_t>(arena.allocate(1, 1));
+        auto y = reinterpret_cast<std::uintptr_t>(arena.create<Wide>());
+        pointersAreAligned = pointersAreAligned && x != 0 && y % alignof(Wide) == 0;
+    }
+
+    Check(pointersAreAligned, "allocations honor alignment");
+    auto big = static_cast<char *>(arena.allocate(4 * 1024 * 1024, 16));
+    big[4 * 1024 * 1024 - 1] = 1;
+    Arena arena2(std::move(arena));
+    bool valuesAreKept = true;
+
+    for (int i = 0; i < static_cast<int>(integers.size()); ++i) {
+        valuesAreKept = valuesAreKept && *integers[i] == i;
+    }
+
+    Check(valuesAreKept, "objects survive chunk growth and moves");
+}
+
+
+void
+TestArrays()
+{
+    Arena arena;
+    Check(arena.makeArray<int>(nullptr, 0).isEmpty(), "empty array");
+    std::vector<double> elements = {1.5, 2.5, 3.5};
+    ArenaArray<double> array = arena.makeArray(elements.data(), elements.size());
+    elements.clear();
+    double sum = 0;
+
+    for (double element : array) {
+        sum += element;
+    }
+
+    Check(array.getSize() == 3 && array[1] == 2.5 && sum == 7.5, "array copies its elements");
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,120 @@
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+#include "CharSearch.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+const char Alphabet[] = " \t\n\r\v\fazAZ09_\"\\*/.+\x80\xff";
+
+
+std::string MakeRun(std::uint32_t *, int);
+template <class T>
+const char *FindFirst(const char *, const char *, T &&);
+void TestKernels();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestKernels();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::string
+MakeRun(std::uint32_t *state, int length)
+{
+    std::string run;
+    // Runs of a single class are what the kernels skip, so most chars repeat the previous one.
+    char c = Alphabet[0];
+
+    for (int i = 0; i < length; ++i) {
+        *state = *state * 1103515245 + 12345;
+
+        if ((*state >> 16) % 8 == 0) {
+            c = Alphabet[(*state >> 20) % (sizeof(Alphabet) - 1)];
+        }
+
+        run += c;
+    }
+
+    return run;
+}
+
+
+template <class T>
+const char *
+FindFirst(const char *first, const char *last, T &&predicate)
+{
+    while (first < last && !predicate(static_cast<unsigned char>(*first))) {
+        ++first;
+    }
+
+    return first;
+}
+
+
+void
+TestKernels()
+{
+    auto isNotWhiteSpace = [] (int c) -> bool {
+        return !std::isspace(c);
+    };
+
+    auto isNotNameChar = [] (int c) -> bool {
+        return !std::isalnum(c) && c != '_';
+    };
+
+    auto isStringLiteralDelimiter = [] (int c) -> bool {
+        return c == '"' || c == '\\' || c == '\n';
+    };
+
+    auto isStar = [] (int c) -> bool {
+        return c == '*';
+    };
+
+    std::uint32_t state = 1;
+    bool whiteSpacesAreSkipped = true;
+    bool nameCharsAreSkipped = true;
+    bool delimitersAreFound = true;
+    bool charsAreFound = true;
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string run = MakeRun(&state, i % 200);
+        const char *last = run.data() + run.size();
+
+        for (const char *first = run.data(); first <= last; ++first) {
+            whiteSpacesAreSkipped = whiteSpacesAreSkipped && SkipWhiteSpaces(first, last)
+                                    == FindFirst(first, last, isNotWhiteSpace);
+            nameCharsAreSkipped = nameCharsAreSkipped && SkipNameChars(first, last)
+                                  == FindFirst(first, last, isNotNameChar);
+            delimitersAreFound = delimitersAreFound && FindStringLiteralDelimiter(first, last)
+                                 == FindFirst(first, last, isStringLiteralDelimiter);
+            charsAreFound = charsAreFound && FindChar(first, last, '*')
+                            == FindFirst(first, last, isStar);
+        }
+    }
+
+    Check(whiteSpacesAreSkipped, "SkipWhiteSpaces");
+    Check(nameCharsAreSkipped, "SkipNameChars");
+    Check(delimitersAreFound, "FindStringLiteralDelimiter");
+    Check(charsAreFound, "FindChar");
+}
+
+} // namespace
+
+} // namespace OYC
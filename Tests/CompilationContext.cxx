@@ -0,0 +1,91 @@
+// CompilationContext is internal to the compiler, so this test includes Compiler.cxx; Compiler.o
+// in the library is then never pulled in.
+#include "../Source/Compiler.cxx"
+
+#include "Function.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+int GetRegisterID(CompilationContext *, SymbolID);
+void TestShadowing();
+void TestSuperRegisters();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestShadowing();
+    OYC::TestSuperRegisters();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+int
+GetRegisterID(CompilationContext *context, SymbolID registerName)
+{
+    context->pushRegisterID(registerName);
+    return context->popRegisterID();
+}
+
+
+void
+TestShadowing()
+{
+    Function function;
+    CompilationContext context(nullptr, &function);
+    context.addRegister(1);
+    context.addRegister(2);
+    int numberOfRegisters = context.getNumberOfRegisters();
+    context.addRegister(1);
+    context.pushRegisterID();
+    Check(context.popRegisterID() == 3 && context.getNumberOfRegisters() == 3
+          , "temporary register");
+    context.addRegister(2);
+    Check(GetRegisterID(&context, 1) == 2 && GetRegisterID(&context, 2) == 3
+          , "inner names shadow outer names");
+    context.deleteRegisters(numberOfRegisters);
+    Check(context.getNumberOfRegisters() == 2 && GetRegisterID(&context, 1) == 0
+          && GetRegisterID(&context, 2) == 1, "deleting registers restores shadowed names");
+}
+
+
+void
+TestSuperRegisters()
+{
+    Function function1;
+    CompilationContext context1(nullptr, &function1);
+
+    for (SymbolID registerName = 1; registerName <= 1000; ++registerName) {
+        context1.addRegister(registerName);
+    }
+
+    Function function2;
+    CompilationContext context2(&context1, &function2);
+    context2.addRegister(500);
+    bool registerIDsAreFound = true;
+
+    for (SymbolID registerName = 1; registerName <= 1000; ++registerName) {
+        registerIDsAreFound = registerIDsAreFound
+                              && context2.getSuperRegisterID(registerName)
+                                 == static_cast<int>(registerName) - 1;
+    }
+
+    Check(registerIDsAreFound && GetRegisterID(&context2, 500) == 0
+          , "super registers are looked up in the enclosing context");
+}
+
+} // namespace
+
+} // namespace OYC
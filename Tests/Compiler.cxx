@@ -0,0 +1,140 @@
+#include <string_view>
+
+#include "Compiler.h"
+#include "Error.h"
+#include "Expression.h"
+#include "Function.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "Statement.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+Function Compile(std::string_view);
+const Instruction *FindInstruction(const Function &, OpCode);
+void TestFunctions();
+void TestEvaluationOrder();
+void TestErrors();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestFunctions();
+    OYC::TestEvaluationOrder();
+    OYC::TestErrors();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+Function
+Compile(std::string_view source)
+{
+    Scanner scanner;
+    scanner.setInput(source);
+    Parser parser;
+    parser.setInput(&scanner);
+    Program program = parser.readProgram();
+    Compiler compiler;
+    return compiler.generateFunction(program);
+}
+
+
+const Instruction *
+FindInstruction(const Function &function, OpCode opCode)
+{
+    for (const Instruction &instruction : function.code) {
+        if (instruction.opCode == opCode) {
+            return &instruction;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void
+TestFunctions()
+{
+    Function function = Compile("auto x = 1;\n"
+                                "auto f = func(auto y, ...) {\n"
+                                "    return x + y;\n"
+                                "};\n");
+    Check(!function.code.empty() && function.code.back().opCode == OpCode::ReturnNull
+          , "functions end with ReturnNull");
+    Check(function.code.size() == function.lineNumbers.size(), "one line number per instruction");
+    Check(function.functions.size() == 1, "nested function");
+
+    if (function.functions.size() == 1) {
+        const Function &f = function.functions[0];
+        Check(f.numberOfParameters == 1 && f.isVariadic, "parameters");
+        Check(f.upvalueDescriptors.size() == 1 && f.upvalueDescriptors[0].superRegisterID == 0
+              , "upvalue descriptor names the parent register");
+        Check(f.lineNumbers.size() == f.code.size() && f.lineNumbers[0] == 3
+              , "nested line numbers");
+    }
+}
+
+
+void
+TestEvaluationOrder()
+{
+    Function function1 = Compile("auto a = 1;\n"
+                                 "return a + 1;\n");
+    const Instruction *instruction1 = FindInstruction(function1, OpCode::Add);
+    Check(instruction1 != nullptr && instruction1->b == 0, "variable operands are used in place");
+    Function function2 = Compile("auto a = 1;\n"
+                                 "return a + (a = 10);\n");
+    const Instruction *instruction2 = FindInstruction(function2, OpCode::Add);
+    Check(instruction2 != nullptr && instruction2->b != 0
+          , "variable operands are copied before a later operand writes them");
+    Function function3 = Compile("auto a = {0}, i = 0;\n"
+                                 "a[i] = i++;\n");
+    const Instruction *instruction3 = FindInstruction(function3, OpCode::SetElement);
+    Check(instruction3 != nullptr && instruction3->b != 1
+          , "element keys are copied before the value writes them");
+}
+
+
+void
+TestErrors()
+{
+    bool isThrown = false;
+
+    try {
+        Compile("auto a = 1;\n"
+                "  1 = a;\n");
+    } catch (const Error::NonLvalueExpression &error) {
+        isThrown = error.getLineNumber() == 2 && error.getColumnNumber() == 3;
+    }
+
+    Check(isThrown, "assignment to a non-lvalue");
+    isThrown = false;
+
+    try {
+        Compile("while (true) {\n"
+                "    func() { continue; };\n"
+                "}\n");
+    } catch (const Error::MisplacedStatement &error) {
+        isThrown = error.getLineNumber() == 2 && error.getColumnNumber() == 14;
+    }
+
+    Check(isThrown, "continue outside a loop");
+}
+
+} // namespace
+
+} // namespace OYC
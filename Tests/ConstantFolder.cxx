@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <string_view>
+
+#include "ConstantFolder.h"
+#include "Expression.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "Statement.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+Program Fold(std::string_view);
+const Expression *GetInitializer(const Program &, std::size_t);
+const PrimaryExpression *GetPrimaryExpression(const Program &, std::size_t
+                                              , PrimaryExpressionType);
+void TestFolding();
+void TestNonFolding();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestFolding();
+    OYC::TestNonFolding();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+Program
+Fold(std::string_view source)
+{
+    Scanner scanner;
+    scanner.setInput(source);
+    Parser parser;
+    parser.setInput(&scanner);
+    Program program = parser.readProgram();
+    ConstantFolder constantFolder;
+    constantFolder.foldProgram(&program);
+    return program;
+}
+
+
+const Expression *
+GetInitializer(const Program &program, std::size_t statementIndex)
+{
+    if (statementIndex >= program.main.body.getSize()) {
+        return nullptr;
+    }
+
+    auto autoStatement = dynamic_cast<const AutoStatement *>(program.main.body[statementIndex]);
+
+    if (autoStatement == nullptr || autoStatement->variableDeclarators.isEmpty()) {
+        return nullptr;
+    }
+
+    return autoStatement->variableDeclarators[0].initializer;
+}
+
+
+const PrimaryExpression *
+GetPrimaryExpression(const Program &program, std::size_t statementIndex
+                     , PrimaryExpressionType type)
+{
+    const Expression *initializer = GetInitializer(program, statementIndex);
+    auto primaryExpression = dynamic_cast<const PrimaryExpression *>(initializer);
+    return primaryExpression != nullptr && primaryExpression->type == type ? primaryExpression
+                                                                           : nullptr;
+}
+
+
+void
+TestFolding()
+{
+    Program program = Fold("auto a = 1 + 2 * 3 - (10 / 3) % 2;\n"
+                           "auto b = 1.5 * 2 + 1;\n"
+                           "auto c = (int)\"3\" + (float)\"2.5\";\n"
+                           "auto d = \"ab\" + \"cd\";\n"
+                           "auto e = 1 < 2 ? 1 << 70 : 0;\n"
+                           "auto f = !(0.0 / 0.0 < 1);\n"
+                           "auto g = sizeof \"hello\";\n");
+    const PrimaryExpression *a = GetPrimaryExpression(program, 0, PrimaryExpressionType::Integer);
+    Check(a != nullptr && a->integer == 6, "integer arithmetic");
+    const PrimaryExpression *b = GetPrimaryExpression(program, 1
+                                                      , PrimaryExpressionType::FloatingPoint);
+    Check(b != nullptr && b->floatingPoint == 4.0, "floating-point arithmetic");
+    const PrimaryExpression *c = GetPrimaryExpression(program, 2
+                                                      , PrimaryExpressionType::FloatingPoint);
+    Check(c != nullptr && c->floatingPoint == 5.5, "casts");
+    const PrimaryExpression *d = GetPrimaryExpression(program, 3, PrimaryExpressionType::String);
+    Check(d != nullptr && program.data.strings.getString(d->string) == "abcd"
+          , "string concatenation");
+    const PrimaryExpression *e = GetPrimaryExpression(program, 4, PrimaryExpressionType::Integer);
+    Check(e != nullptr && e->integer == 64, "ternary and shift count masking");
+    const PrimaryExpression *f = GetPrimaryExpression(program, 5, PrimaryExpressionType::Boolean);
+    Check(f != nullptr && f->boolean, "NaN comparison");
+    const PrimaryExpression *g = GetPrimaryExpression(program, 6, PrimaryExpressionType::Integer);
+    Check(g != nullptr && g->integer == 5, "sizeof string");
+}
+
+
+void
+TestNonFolding()
+{
+    Program program = Fold("auto x = -0.0;\n"
+                           "auto a = 1 / 0;\n"
+                           "auto b = 9007199254740993 == 9007199254740992.0;\n"
+                           "auto c = x + 0;\n"
+                           "auto d = -\"s\";\n");
+    Check(dynamic_cast<const BinaryExpression *>(GetInitializer(program, 1)) != nullptr
+          , "division by zero is left to the interpreter");
+    Check(dynamic_cast<const BinaryExpression *>(GetInitializer(program, 2)) != nullptr
+          , "mixed integer/floating-point equality is left to the interpreter");
+    Check(dynamic_cast<const BinaryExpression *>(GetInitializer(program, 3)) != nullptr
+          , "x + 0 keeps the sign of zero");
+    Check(dynamic_cast<const UnaryExpression *>(GetInitializer(program, 4)) != nullptr
+          , "type errors are left to the interpreter");
+}
+
+} // namespace
+
+} // namespace OYC
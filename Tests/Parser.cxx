@@ -0,0 +1,305 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Error.h"
+#include "Expression.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "Statement.h"
+#include "Test.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+Program Parse(std::string_view, bool = false);
+const Expression *GetInitializer(const Program &, std::size_t);
+bool IsCast(const Expression *, TokenType);
+void TestCasts();
+void TestLongProgram();
+void TestPositions();
+void TestLiteralIds();
+const FunctionLiteral *FindFunctionLiteral(const Program &, std::size_t);
+bool NamesAre(const Program &, const std::vector<SymbolID> &, std::vector<std::string_view>);
+void TestScopes();
+void TestForeach();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestCasts();
+    OYC::TestLongProgram();
+    OYC::TestPositions();
+    OYC::TestLiteralIds();
+    OYC::TestScopes();
+    OYC::TestForeach();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+Program
+Parse(std::string_view source, bool lazyPositioning)
+{
+    Scanner scanner;
+    scanner.setInput(source);
+    scanner.setLazyPositioning(lazyPositioning);
+    Parser parser;
+    parser.setInput(&scanner);
+    return parser.readProgram();
+}
+
+
+const Expression *
+GetInitializer(const Program &program, std::size_t statementIndex)
+{
+    if (statementIndex >= program.main.body.getSize()) {
+        return nullptr;
+    }
+
+    auto autoStatement = dynamic_cast<const AutoStatement *>(program.main.body[statementIndex]);
+
+    if (autoStatement == nullptr || autoStatement->variableDeclarators.isEmpty()) {
+        return nullptr;
+    }
+
+    return autoStatement->variableDeclarators[0].initializer;
+}
+
+
+bool
+IsCast(const Expression *expression, TokenType tokenType)
+{
+    auto unaryExpression = dynamic_cast<const UnaryExpression *>(expression);
+    return unaryExpression != nullptr && unaryExpression->type == UnaryExpressionType::Prefix
+           && unaryExpression->op == tokenType;
+}
+
+
+void
+TestCasts()
+{
+    Program program = Parse("auto x = 1;\n"
+                            "auto a = (int)(float)x;\n"
+                            "auto b = (x) - (str)x;\n");
+    auto a = dynamic_cast<const UnaryExpression *>(GetInitializer(program, 1));
+    Check(IsCast(a, TokenType::IntKeyword) && IsCast(a->operand, TokenType::FloatKeyword)
+          , "nested casts");
+    auto b = dynamic_cast<const BinaryExpression *>(GetInitializer(program, 2));
+    Check(b != nullptr && b->op == MakeTokenType('-')
+          && dynamic_cast<const PrimaryExpression *>(b->operand1) != nullptr
+          && IsCast(b->operand2, TokenType::StrKeyword)
+          , "parenthesized operand followed by a cast");
+}
+
+
+void
+TestLongProgram()
+{
+    std::string source;
+    const std::size_t numberOfStatements = 10000;
+
+    for (std::size_t i = 0; i < numberOfStatements; ++i) {
+        source += "auto v" + std::to_string(i) + " = (int)(" + std::to_string(i)
+                  + " + 1) * -(float)2;\n";
+    }
+
+    Program program = Parse(source);
+    bool castsAreParsed = program.main.body.getSize() == numberOfStatements;
+
+    for (std::size_t i = 0; castsAreParsed && i < program.main.body.getSize(); ++i) {
+        auto binaryExpression = dynamic_cast<const BinaryExpression *>(GetInitializer(program, i));
+        castsAreParsed = binaryExpression != nullptr && binaryExpression->op == MakeTokenType('*')
+                         && IsCast(binaryExpression->operand1, TokenType::IntKeyword);
+    }
+
+    Check(castsAreParsed, "lookahead across a long program");
+}
+
+
+
+void
+TestPositions()
+{
+    for (int i = 0; i < 2; ++i) {
+        bool lazyPositioning = i == 1;
+        Program program = Parse("auto x = 1;\n"
+                                "/* comment */ x = 2;\n", lazyPositioning);
+        Check(program.main.body.getSize() == 2 && program.main.body[1]->lineNumber == 2
+              && program.main.body[1]->columnNumber == 15, "statement position");
+        bool isThrown = false;
+
+        try {
+            Parse("auto x = 1;\n"
+                  "\n"
+                  "  x = = 2;\n", lazyPositioning);
+        } catch (const Error::UnexpectedToken &error) {
+            isThrown = error.getLineNumber() == 3 && error.getColumnNumber() == 7;
+        }
+
+        Check(isThrown, "unexpected token position");
+    }
+}
+
+
+
+void
+TestLiteralIds()
+{
+    std::string source;
+    const int numberOfFunctions = 100;
+
+    for (int i = 0; i < numberOfFunctions; ++i) {
+        source += "auto f" + std::to_string(i) + " = func() { return {dict {.x = {"
+                  + std::to_string(i) + "}}}; };\n";
+    }
+
+    Program program = Parse(source);
+    const ProgramData &data = program.data;
+    Check(program.main.id == -1, "main has no id");
+    Check(data.functionLiterals.getSize() == numberOfFunctions
+          && data.arrayLiterals.getSize() == 2 * numberOfFunctions
+          && data.dictionaryLiterals.getSize() == numberOfFunctions, "literal counts");
+    bool idsAreDense = true;
+
+    for (int i = 0; i < data.functionLiterals.getSize(); ++i) {
+        idsAreDense = idsAreDense && data.functionLiterals[i].id == i;
+    }
+
+    for (int i = 0; i < data.arrayLiterals.getSize(); ++i) {
+        idsAreDense = idsAreDense && data.arrayLiterals[i].id == i;
+    }
+
+    for (int i = 0; i < data.dictionaryLiterals.getSize(); ++i) {
+        idsAreDense = idsAreDense && data.dictionaryLiterals[i].id == i;
+    }
+
+    Check(idsAreDense, "literal ids are their indexes");
+    bool literalsAreStable = true;
+
+    for (int i = 0; i < numberOfFunctions; ++i) {
+        const Expression *initializer = GetInitializer(program, i);
+        auto primaryExpression = dynamic_cast<const PrimaryExpression *>(initializer);
+        literalsAreStable = literalsAreStable && primaryExpression != nullptr
+                            && primaryExpression->type == PrimaryExpressionType::FunctionLiteral
+                            && primaryExpression->functionLiteral
+                               == &data.functionLiterals[primaryExpression->functionLiteral->id];
+    }
+
+    Check(literalsAreStable, "expressions point at the stored literals");
+}
+
+
+
+const FunctionLiteral *
+FindFunctionLiteral(const Program &program, std::size_t numberOfParameters)
+{
+    for (int i = 0; i < program.data.functionLiterals.getSize(); ++i) {
+        if (program.data.functionLiterals[i].parameters.size() == numberOfParameters) {
+            return &program.data.functionLiterals[i];
+        }
+    }
+
+    return nullptr;
+}
+
+
+bool
+NamesAre(const Program &program, const std::vector<SymbolID> &symbolIDs
+         , std::vector<std::string_view> names)
+{
+    if (symbolIDs.size() != names.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < symbolIDs.size(); ++i) {
+        if (program.data.strings.getString(symbolIDs[i]) != names[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void
+TestScopes()
+{
+    Program program = Parse("auto a = 1, b = 2, c = 3;\n"
+                            "auto f = func(auto p) {\n"
+                            "    auto g = func(auto p, auto q) {\n"
+                            "        if (a) {\n"
+                            "            b = a;\n"
+                            "        }\n"
+                            "\n"
+                            "        return a + b + p;\n"
+                            "    };\n"
+                            "\n"
+                            "    auto c = p;\n"
+                            "    return func(auto p, auto q, auto r) { return c + b; };\n"
+                            "};\n");
+    const FunctionLiteral *f = FindFunctionLiteral(program, 1);
+    const FunctionLiteral *g = FindFunctionLiteral(program, 2);
+    const FunctionLiteral *h = FindFunctionLiteral(program, 3);
+    Check(g != nullptr && NamesAre(program, g->superVariableNames, {"a", "b"})
+          , "each captured variable is recorded once");
+    Check(f != nullptr && NamesAre(program, f->superVariableNames, {"a", "b"})
+          , "captures pass through enclosing functions");
+    Check(h != nullptr && NamesAre(program, h->superVariableNames, {"c", "b"})
+          , "captures resolve to the innermost binding");
+    bool isThrown = false;
+
+    try {
+        Parse("if (true) {\n"
+              "    auto x = 1;\n"
+              "}\n"
+              "x = 2;\n");
+    } catch (const Error::UndeclaredVariable &error) {
+        isThrown = error.getLineNumber() == 4 && error.getColumnNumber() == 1;
+    }
+
+    Check(isThrown, "variables go out of scope at the end of a block");
+}
+
+
+void
+TestForeach()
+{
+    Program program = Parse("foreach (auto k, v : {}) {}\n"
+                            "foreach (auto v : {}) {}\n");
+    auto foreach1 = dynamic_cast<const ForeachStatement *>(program.main.body[0]);
+    auto foreach2 = dynamic_cast<const ForeachStatement *>(program.main.body[1]);
+    Check(foreach1 != nullptr
+          && program.data.strings.getString(foreach1->variableName1) == "k"
+          && program.data.strings.getString(foreach1->variableName2) == "v"
+          , "key-value foreach");
+    Check(foreach2 != nullptr && foreach2->variableName1 == NoSymbolID
+          && program.data.strings.getString(foreach2->variableName2) == "v"
+          , "value-only foreach");
+    bool isThrown = false;
+
+    try {
+        Parse("foreach (auto v; {}) {}\n");
+    } catch (const Error::UnexpectedToken &error) {
+        isThrown = error.getColumnNumber() == 16;
+    }
+
+    Check(isThrown, "foreach variables are followed by ',' or ':'");
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,263 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Scanner.h"
+#include "Test.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+const char *const Source = "auto x = 0x1F + 2.5e3; // comment\n"
+                           "/* block\n   comment */ if (x >= 10) { s = \"a\\tb\"; }\n";
+
+
+std::vector<Token> ScanAll(Scanner *);
+void SetCallbackInput(Scanner *, std::string_view);
+bool InputModesAgree(std::string_view);
+bool TokensAreEqual(const std::vector<Token> &, const std::vector<Token> &);
+std::string MakeLongSource();
+void TestTokens();
+void TestInputModes();
+void TestViews();
+void TestLazyPositions();
+void TestSignificantTokens();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestTokens();
+    OYC::TestInputModes();
+    OYC::TestViews();
+    OYC::TestLazyPositions();
+    OYC::TestSignificantTokens();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::vector<Token>
+ScanAll(Scanner *scanner)
+{
+    std::vector<Token> tokens;
+
+    do {
+        tokens.push_back(scanner->readToken());
+    } while (tokens.back().type != TokenType::EndOfFile);
+
+    return tokens;
+}
+
+
+void
+SetCallbackInput(Scanner *scanner, std::string_view source)
+{
+    std::size_t i = 0;
+
+    scanner->setInput([source, i] () mutable -> int {
+        return i < source.size() ? static_cast<unsigned char>(source[i++]) : -1;
+    });
+}
+
+
+bool
+InputModesAgree(std::string_view source)
+{
+    Scanner scanner1;
+    scanner1.setInput(source);
+    Scanner scanner2;
+    SetCallbackInput(&scanner2, source);
+    return TokensAreEqual(ScanAll(&scanner1), ScanAll(&scanner2));
+}
+
+
+bool
+TokensAreEqual(const std::vector<Token> &tokens1, const std::vector<Token> &tokens2)
+{
+    if (tokens1.size() != tokens2.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < tokens1.size(); ++i) {
+        if (tokens1[i].type != tokens2[i].type || tokens1[i].value != tokens2[i].value
+            || tokens1[i].lineNumber != tokens2[i].lineNumber
+            || tokens1[i].columnNumber != tokens2[i].columnNumber) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::string
+MakeLongSource()
+{
+    std::string source;
+
+    for (int i = 0; i < 2000; ++i) {
+        source += "auto name" + std::to_string(i) + " = \"" + std::string(i % 37, 'x')
+                  + "\"; /* " + std::string(i % 53, '*') + " */ // " + std::to_string(i * 7)
+                  + "\n" + std::string(i % 17, ' ') + "\t" + std::to_string(i * 1.5) + ";\n";
+    }
+
+    return source;
+}
+
+
+void
+TestTokens()
+{
+    Scanner scanner;
+    scanner.setInput(Source);
+    std::vector<Token> tokens;
+
+    for (const Token &token : ScanAll(&scanner)) {
+        if (token.type != TokenType::WhiteSpace) {
+            tokens.push_back(token);
+        }
+    }
+
+    Check(tokens.size() == 22, "significant token count");
+
+    if (tokens.size() != 22) {
+        return;
+    }
+
+    Check(tokens[0].type == TokenType::AutoKeyword, "auto keyword");
+    Check(tokens[1].type == TokenType::Identifier && tokens[1].value == "x", "identifier");
+    Check(tokens[2].type == MakeTokenType('='), "assignment operator");
+    Check(tokens[3].type == TokenType::IntegerLiteral && tokens[3].value == "0x1F"
+          , "hexadecimal literal");
+    Check(tokens[5].type == TokenType::FloatingPointLiteral && tokens[5].value == "2.5e3"
+          , "floating-point literal");
+    Check(tokens[7].type == TokenType::Comment && tokens[7].value == "// comment"
+          , "line comment");
+    Check(tokens[8].type == TokenType::Comment && tokens[8].lineNumber == 2
+          && tokens[8].columnNumber == 1, "block comment position");
+    Check(tokens[9].type == TokenType::IfKeyword && tokens[9].lineNumber == 3
+          && tokens[9].columnNumber == 15, "position after a multi-line comment");
+    Check(tokens[12].type == MakeTokenType('>', '='), "two-char operator");
+    Check(tokens[18].type == TokenType::StringLiteral && tokens[18].value == "\"a\\tb\""
+          , "string literal is kept verbatim");
+    Check(tokens[21].type == TokenType::EndOfFile && tokens[21].lineNumber == 4
+          , "end of file");
+}
+
+
+void
+TestInputModes()
+{
+    Check(InputModesAgree(Source), "buffer and callback input agree");
+    Check(InputModesAgree(MakeLongSource()), "buffer and callback input agree on a long source");
+    Check(InputModesAgree(""), "empty input");
+}
+
+
+
+void
+TestViews()
+{
+    std::string_view source = Source;
+    Scanner scanner1;
+    scanner1.setInput(source);
+    bool viewsAreInBuffer = true;
+
+    for (const Token &token : ScanAll(&scanner1)) {
+        viewsAreInBuffer = viewsAreInBuffer && token.value.data() >= source.data()
+                           && token.value.data() + token.value.size()
+                              <= source.data() + source.size()
+                           && source.substr(token.offset, token.value.size()) == token.value;
+    }
+
+    Check(viewsAreInBuffer, "buffer mode views point into the input at their offsets");
+    std::string longSource = MakeLongSource();
+    Scanner scanner2;
+    SetCallbackInput(&scanner2, longSource);
+    std::vector<Token> tokens = ScanAll(&scanner2);
+    bool viewsAreValid = true;
+
+    for (const Token &token : tokens) {
+        viewsAreValid = viewsAreValid
+                        && longSource.compare(token.offset, token.value.size(), token.value) == 0;
+    }
+
+    Check(viewsAreValid, "callback mode views stay valid across input blocks");
+}
+
+
+
+void
+TestLazyPositions()
+{
+    std::string longSource = MakeLongSource();
+
+    for (int i = 0; i < 2; ++i) {
+        Scanner scanner1;
+        scanner1.setInput(longSource);
+        std::vector<Token> tokens1 = ScanAll(&scanner1);
+        Scanner scanner2;
+        scanner2.setLazyPositioning(true);
+
+        if (i == 0) {
+            scanner2.setInput(longSource);
+        } else {
+            SetCallbackInput(&scanner2, longSource);
+        }
+
+        std::vector<Token> tokens2;
+        bool positionsAreDeferred = true;
+
+        for (Token token : ScanAll(&scanner2)) {
+            positionsAreDeferred = positionsAreDeferred && token.lineNumber == 0;
+            scanner2.locateToken(&token);
+            tokens2.push_back(token);
+        }
+
+        Check(positionsAreDeferred, "lazy positioning leaves positions unresolved");
+        Check(TokensAreEqual(tokens1, tokens2), "located positions match eager positions");
+    }
+}
+
+
+
+void
+TestSignificantTokens()
+{
+    std::string longSource = MakeLongSource();
+    Scanner scanner1;
+    scanner1.setInput(longSource);
+    std::vector<Token> tokens1;
+
+    for (const Token &token : ScanAll(&scanner1)) {
+        if (token.type != TokenType::WhiteSpace && token.type != TokenType::Comment) {
+            tokens1.push_back(token);
+        }
+    }
+
+    Scanner scanner2;
+    SetCallbackInput(&scanner2, longSource);
+    std::vector<Token> tokens2;
+
+    do {
+        tokens2.push_back(scanner2.readSignificantToken());
+    } while (tokens2.back().type != TokenType::EndOfFile);
+
+    Check(TokensAreEqual(tokens1, tokens2), "significant tokens skip white spaces and comments");
+}
+
+} // namespace
+
+} // namespace OYC
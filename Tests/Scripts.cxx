@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Compiler.h"
+#include "ConstantFolder.h"
+#include "Function.h"
+#include "Interpreter.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "SourceFile.h"
+#include "Test.h"
+#include "Value.h"
+
+
+// Runs every Tests/*.oyc script with and without constant folding; a script passes when it
+// returns true.
+namespace OYC {
+
+namespace {
+
+std::vector<std::string> GetScriptFileNames();
+bool RunScript(const std::string &, bool);
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    std::vector<std::string> scriptFileNames = OYC::GetScriptFileNames();
+    OYC::Check(!scriptFileNames.empty(), "scripts found");
+
+    for (const std::string &scriptFileName : scriptFileNames) {
+        OYC::Check(OYC::RunScript(scriptFileName, false), scriptFileName.c_str());
+        OYC::Check(OYC::RunScript(scriptFileName, true), (scriptFileName + " (folded)").c_str());
+    }
+
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::vector<std::string>
+GetScriptFileNames()
+{
+    std::vector<std::string> scriptFileNames;
+
+    for (const std::filesystem::directory_entry &entry
+         : std::filesystem::directory_iterator("Tests")) {
+        if (entry.path().extension() == ".oyc") {
+            scriptFileNames.push_back(entry.path().string());
+        }
+    }
+
+    std::sort(scriptFileNames.begin(), scriptFileNames.end());
+    return scriptFileNames;
+}
+
+
+bool
+RunScript(const std::string &scriptFileName, bool foldsConstants)
+{
+    try {
+        SourceFile sourceFile(scriptFileName.c_str());
+        Scanner scanner;
+        scanner.setInput(sourceFile);
+        Parser parser;
+        parser.setInput(&scanner);
+        Program program = parser.readProgram();
+
+        if (foldsConstants) {
+            ConstantFolder constantFolder;
+            constantFolder.foldProgram(&program);
+        }
+
+        Compiler compiler;
+        Function function = compiler.generateFunction(program);
+        Interpreter interpreter;
+        Value result = interpreter.execute(function, {});
+        return result.getType() == ValueType::Boolean && result.getBoolean();
+    } catch (const std::exception &exception) {
+        std::fprintf(stderr, "%s: %s\n", scriptFileName.c_str(), exception.what());
+        return false;
+    }
+}
+
+} // namespace
+
+} // namespace OYC
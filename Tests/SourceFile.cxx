@@ -0,0 +1,138 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#include "Scanner.h"
+#include "SourceFile.h"
+#include "Test.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+std::string MakeTemporaryFile(const std::string &);
+void TestRegularFile();
+void TestEmptyFile();
+void TestPipe();
+void TestMissingFile();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestRegularFile();
+    OYC::TestEmptyFile();
+    OYC::TestPipe();
+    OYC::TestMissingFile();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::string
+MakeTemporaryFile(const std::string &text)
+{
+    char fileName[] = "/tmp/OYCSourceFileXXXXXX";
+    int fd = mkstemp(fileName);
+
+    if (fd < 0 || write(fd, text.data(), text.size()) != static_cast<ssize_t>(text.size())) {
+        std::perror("MakeTemporaryFile");
+        std::exit(1);
+    }
+
+    close(fd);
+    return fileName;
+}
+
+
+void
+TestRegularFile()
+{
+    std::string text(100000, ' ');
+    text += "auto x = 1;\n";
+    std::string fileName = MakeTemporaryFile(text);
+
+    {
+        SourceFile sourceFile(fileName.c_str());
+        Check(sourceFile.getText() == text, "regular file text");
+        Scanner scanner;
+        scanner.setInput(sourceFile);
+        Check(scanner.readToken().type == TokenType::WhiteSpace, "scan a source file");
+        Token token = scanner.readToken();
+        Check(token.type == TokenType::AutoKeyword && token.columnNumber == 100001
+              , "scan a source file past the first page");
+    }
+
+    unlink(fileName.c_str());
+}
+
+
+void
+TestEmptyFile()
+{
+    std::string fileName = MakeTemporaryFile("");
+
+    {
+        SourceFile sourceFile(fileName.c_str());
+        Check(sourceFile.getText().empty(), "empty file text");
+    }
+
+    unlink(fileName.c_str());
+}
+
+
+void
+TestPipe()
+{
+    int fds[2];
+
+    if (pipe(fds) < 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+
+    std::string text = "return 0;";
+    Check(write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size())
+          , "write to pipe");
+    close(fds[1]);
+    std::string fileName = "/dev/fd/" + std::to_string(fds[0]);
+
+    {
+        SourceFile sourceFile(fileName.c_str());
+        Check(sourceFile.getText() == text, "pipe text");
+    }
+
+    close(fds[0]);
+}
+
+
+void
+TestMissingFile()
+{
+    bool isThrown = false;
+
+    try {
+        SourceFile sourceFile("/nonexistent/file.oyc");
+    } catch (const std::system_error &exception) {
+        isThrown = std::string(exception.what()).find("/nonexistent/file.oyc")
+                   != std::string::npos;
+    }
+
+    Check(isThrown, "missing file throws std::system_error naming the file");
+}
+
+} // namespace
+
+} // namespace OYC
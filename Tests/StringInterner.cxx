@@ -0,0 +1,80 @@
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "StringInterner.h"
+#include "Test.h"
+
+
+namespace OYC {
+
+namespace {
+
+std::vector<std::string> MakeStrings();
+void TestIntern();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestIntern();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+std::vector<std::string>
+MakeStrings()
+{
+    std::vector<std::string> strings = {"", std::string("a\0b", 3), std::string(10000, 'x')};
+
+    for (int i = 0; i < 50000; ++i) {
+        strings.push_back("name" + std::to_string(i));
+    }
+
+    return strings;
+}
+
+
+void
+TestIntern()
+{
+    std::vector<std::string> strings = MakeStrings();
+    StringInterner stringInterner1;
+    bool symbolIDsAreDense = true;
+
+    for (int i = 0; i < static_cast<int>(strings.size()); ++i) {
+        symbolIDsAreDense = symbolIDsAreDense
+                            && stringInterner1.intern(strings[i]) == static_cast<SymbolID>(i + 1);
+    }
+
+    Check(symbolIDsAreDense, "new strings get consecutive symbol ids");
+    Check(stringInterner1.getNumberOfSymbols() == static_cast<int>(strings.size()) + 1
+          , "number of symbols includes NoSymbolID");
+    StringInterner stringInterner2(std::move(stringInterner1));
+    bool symbolsAreStable = true;
+
+    for (int i = 0; i < static_cast<int>(strings.size()); ++i) {
+        std::string copy = strings[i];
+        SymbolID symbolID = stringInterner2.intern(copy);
+        symbolsAreStable = symbolsAreStable && symbolID == static_cast<SymbolID>(i + 1)
+                           && stringInterner2.getString(symbolID) == strings[i]
+                           && stringInterner2.getString(symbolID).data() != copy.data();
+    }
+
+    Check(symbolsAreStable, "interning again returns the same symbol and stored string");
+    Check(stringInterner2.getNumberOfSymbols() == static_cast<int>(strings.size()) + 1
+          , "interning again adds no symbols");
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,34 @@
+#pragma once
+
+
+#include <cstdio>
+
+
+// Each test is a standalone program built together with Source/*.cxx; Tests/run.sh builds and
+// runs all of them. A test reports every failed check and exits with a non-zero status.
+namespace OYC {
+
+inline int NumberOfFailedChecks = 0;
+
+
+inline void Check(bool, const char *);
+inline int GetTestStatus();
+
+
+void
+Check(bool condition, const char *description)
+{
+    if (!condition) {
+        std::fprintf(stderr, "check failed: %s\n", description);
+        ++NumberOfFailedChecks;
+    }
+}
+
+
+int
+GetTestStatus()
+{
+    return NumberOfFailedChecks == 0 ? 0 : 1;
+}
+
+} // namespace OYC
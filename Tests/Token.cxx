@@ -0,0 +1,64 @@
+#include <string>
+#include <type_traits>
+
+#include "Test.h"
+#include "Token.h"
+
+
+namespace OYC {
+
+namespace {
+
+void TestKeywords();
+void TestIdentifiers();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestKeywords();
+    OYC::TestIdentifiers();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+void
+TestKeywords()
+{
+    for (auto k = static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordBegin)
+         ; k < static_cast<std::underlying_type_t<TokenType>>(TokenType::KeywordEnd); ++k) {
+        auto tokenType = static_cast<TokenType>(k);
+        std::string keyword = TokenTypeToString(tokenType);
+        Check(NameToTokenType(keyword) == tokenType, "keyword maps to its token type");
+        Check(NameToTokenType(keyword + "_") == TokenType::Identifier, "keyword with a suffix");
+        Check(NameToTokenType(keyword.substr(0, keyword.size() - 1)) != tokenType
+              , "keyword prefix");
+        keyword[0] = keyword[0] - 'a' + 'A';
+        Check(NameToTokenType(keyword) == TokenType::Identifier, "capitalized keyword");
+    }
+}
+
+
+void
+TestIdentifiers()
+{
+    const char *const identifiers[] = {
+        "", "_", "x", "iff", "dictionary", "continued", "foreach1", "Null", "_if", "9do"
+    };
+
+    for (const char *identifier : identifiers) {
+        Check(NameToTokenType(identifier) == TokenType::Identifier, identifier);
+    }
+}
+
+} // namespace
+
+} // namespace OYC
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include <sys/resource.h>
+
+#include "Compiler.h"
+#include "Function.h"
+#include "Interpreter.h"
+#include "Object.h"
+#include "Parser.h"
+#include "Program.h"
+#include "Scanner.h"
+#include "Test.h"
+#include "Value.h"
+
+
+namespace OYC {
+
+namespace {
+
+void TestImmediates();
+void TestFloatingPoints();
+Value Execute(std::string_view);
+long GetPeakMemoryUsage();
+void TestBoxedIntegerGarbage();
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::TestImmediates();
+    OYC::TestFloatingPoints();
+    OYC::TestBoxedIntegerGarbage();
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+void
+TestImmediates()
+{
+    Check(Value().getType() == ValueType::Null && Value().isNull(), "default value is null");
+    Check(Value::MakeBoolean(true).getType() == ValueType::Boolean
+          && Value::MakeBoolean(true).getBoolean(), "true");
+    Check(!Value::MakeBoolean(false).getBoolean() && !Value::MakeBoolean(false).isNull()
+          , "false is not null");
+    const std::int64_t minimum = -(INT64_C(1) << 47);
+    const std::int64_t maximum = (INT64_C(1) << 47) - 1;
+    Check(Value::IsSmallInteger(minimum) && Value::IsSmallInteger(maximum)
+          && !Value::IsSmallInteger(minimum - 1) && !Value::IsSmallInteger(maximum + 1)
+          , "small integer range");
+    bool integersRoundTrip = true;
+
+    for (std::int64_t integer : {INT64_C(0), INT64_C(1), INT64_C(-1), minimum, maximum}) {
+        Value value = Value::MakeSmallInteger(integer);
+        integersRoundTrip = integersRoundTrip && value.getType() == ValueType::Integer
+                            && value.isSmallInteger() && !value.isObject()
+                            && value.getSmallInteger() == integer && value.getInteger() == integer;
+    }
+
+    Check(integersRoundTrip, "small integers round-trip");
+}
+
+
+void
+TestFloatingPoints()
+{
+    bool floatingPointsRoundTrip = true;
+
+    for (double floatingPoint : {0.0, -0.0, 1.5, -1e308, std::numeric_limits<double>::infinity()
+                                 , -std::numeric_limits<double>::infinity()
+                                 , std::numeric_limits<double>::denorm_min()}) {
+        Value value = Value::MakeFloatingPoint(floatingPoint);
+        floatingPointsRoundTrip = floatingPointsRoundTrip
+                                  && value.getType() == ValueType::FloatingPoint
+                                  && !value.isObject() && !value.isSmallInteger()
+                                  && value.getFloatingPoint() == floatingPoint
+                                  && std::signbit(value.getFloatingPoint())
+                                     == std::signbit(floatingPoint);
+    }
+
+    Check(floatingPointsRoundTrip, "floating points round-trip");
+    bool nansAreCanonical = true;
+
+    for (double nan : {std::numeric_limits<double>::quiet_NaN()
+                       , -std::numeric_limits<double>::quiet_NaN()
+                       , std::numeric_limits<double>::signaling_NaN()}) {
+        Value value = Value::MakeFloatingPoint(nan);
+        nansAreCanonical = nansAreCanonical && value.getType() == ValueType::FloatingPoint
+                           && std::isnan(value.getFloatingPoint());
+    }
+
+    Check(nansAreCanonical, "NaNs stay floating points");
+}
+
+
+Value
+Execute(std::string_view source)
+{
+    Scanner scanner;
+    scanner.setInput(source);
+    Parser parser;
+    parser.setInput(&scanner);
+    Program program = parser.readProgram();
+    Compiler compiler;
+    Function function = compiler.generateFunction(program);
+    Interpreter interpreter;
+    return interpreter.execute(function, {});
+}
+
+
+long
+GetPeakMemoryUsage()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+
+void
+TestBoxedIntegerGarbage()
+{
+    Value result = Execute(R"(
+        auto big = 1 << 50;
+        auto sum = 0;
+
+        for (auto i = 0; i < 5000000; ++i) {
+            sum += (big + i) - big;
+        }
+
+        return sum;
+    )");
+    Check(result.getType() == ValueType::Integer && result.getInteger() == 12499997500000
+          , "boxed integer loop result");
+    result = Execute(R"(
+        auto depth = func(auto depth, auto n) {
+            return n == 0 ? 0 : depth(depth, n - 1) + (1 << 50) * 2 - (1 << 51) + 1;
+        };
+        auto sum = 0;
+
+        for (auto i = 0; i < 5000; ++i) {
+            sum += depth(depth, 1000);
+        }
+
+        return sum;
+    )");
+    Check(result.getType() == ValueType::Integer && result.getInteger() == 5000000
+          , "boxed integer recursion result");
+    Check(GetPeakMemoryUsage() < 64 * 1024, "boxed integers are collected");
+}
+
+} // namespace
+
+} // namespace OYC
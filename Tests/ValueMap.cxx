@@ -0,0 +1,163 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Heap.h"
+#include "Object.h"
+#include "Test.h"
+#include "ValueMap.h"
+
+
+namespace OYC {
+
+namespace {
+
+struct ValueHasher
+{
+    std::size_t operator()(Value value) const
+    {
+        return HashValue(value);
+    }
+};
+
+
+struct ValueEqualityComparer
+{
+    bool operator()(Value value1, Value value2) const
+    {
+        return ValuesAreEqual(value1, value2);
+    }
+};
+
+
+typedef std::unordered_map<Value, Value, ValueHasher, ValueEqualityComparer> UnorderedMap;
+
+
+void TestRandomOperations(const std::vector<Value> &);
+bool MapsAreEqual(const ValueMap &, const UnorderedMap &);
+void TestMixedKeys(Heap *);
+
+} // namespace
+
+} // namespace OYC
+
+
+int
+main()
+{
+    OYC::Heap heap;
+    std::vector<OYC::Value> integerKeys;
+    std::vector<OYC::Value> stringKeys;
+
+    for (int i = 0; i < 3000; ++i) {
+        integerKeys.push_back(OYC::Value::MakeSmallInteger(i));
+        auto string = heap.createObject<OYC::String>();
+        string->value = "key" + std::to_string(i);
+        stringKeys.push_back(OYC::Value::MakeObject(OYC::ValueType::String, string));
+    }
+
+    OYC::TestRandomOperations(integerKeys);
+    OYC::TestRandomOperations(stringKeys);
+    OYC::TestMixedKeys(&heap);
+    return OYC::GetTestStatus();
+}
+
+
+namespace OYC {
+
+namespace {
+
+void
+TestRandomOperations(const std::vector<Value> &keys)
+{
+    std::mt19937 randomNumberGenerator(1);
+    bool resultsAgree = true;
+    bool contentsAgree = true;
+
+    for (int round = 0; round < 50; ++round) {
+        ValueMap map;
+        UnorderedMap unorderedMap;
+        std::size_t numberOfKeys = 1 + randomNumberGenerator() % keys.size();
+
+        for (int i = 0; i < 20000; ++i) {
+            Value key = keys[randomNumberGenerator() % numberOfKeys];
+            unsigned int operation = randomNumberGenerator() % 10;
+
+            if (operation < 5) {
+                map.set(key, Value::MakeSmallInteger(i));
+                unorderedMap[key] = Value::MakeSmallInteger(i);
+            } else if (operation < 8) {
+                resultsAgree = resultsAgree && map.erase(key) == (unorderedMap.erase(key) == 1);
+            } else {
+                Value value = map.get(key);
+                auto it = unorderedMap.find(key);
+                resultsAgree = resultsAgree
+                               && (it == unorderedMap.end()
+                                   ? value.isNull()
+                                   : !value.isNull() && ValuesAreEqual(value, it->second));
+            }
+
+            resultsAgree = resultsAgree && map.getSize() == unorderedMap.size();
+        }
+
+        contentsAgree = contentsAgree && MapsAreEqual(map, unorderedMap);
+    }
+
+    Check(resultsAgree, "operations agree with std::unordered_map");
+    Check(contentsAgree, "entries agree with std::unordered_map");
+}
+
+
+bool
+MapsAreEqual(const ValueMap &map, const UnorderedMap &unorderedMap)
+{
+    std::size_t numberOfValues = 0;
+
+    for (std::size_t i = 0; i < map.getNumberOfEntries(); ++i) {
+        const ValueMap::Entry &entry = map.getEntry(i);
+
+        if (entry.value.isNull()) {
+            continue;
+        }
+
+        auto it = unorderedMap.find(entry.key);
+
+        if (it == unorderedMap.end() || !ValuesAreEqual(it->second, entry.value)) {
+            return false;
+        }
+
+        ++numberOfValues;
+    }
+
+    return numberOfValues == unorderedMap.size();
+}
+
+
+void
+TestMixedKeys(Heap *heap)
+{
+    ValueMap map;
+    auto string = heap->createObject<String>();
+    string->value = "1";
+    Value stringKey = Value::MakeObject(ValueType::String, string);
+    map.set(Value::MakeSmallInteger(1), Value::MakeBoolean(true));
+    map.set(stringKey, Value::MakeBoolean(false));
+    map.set(Value::MakeFloatingPoint(2.5), Value::MakeSmallInteger(3));
+    Check(map.getSize() == 3, "integer, string and floating-point keys are distinct");
+    Check(map.get(Value::MakeFloatingPoint(1.0)).getType() == ValueType::Boolean
+          && map.get(Value::MakeFloatingPoint(1.0)).getBoolean()
+          , "integral floating points find integer keys");
+    Check(map.get(Value::MakeFloatingPoint(2.5)).getSmallInteger() == 3
+          , "floating-point keys");
+    Check(map.erase(Value::MakeSmallInteger(1)) && !map.erase(Value::MakeSmallInteger(1))
+          && map.get(Value::MakeSmallInteger(1)).isNull() && map.getSize() == 2
+          , "erasure");
+    Check(map.getEntry(0).value.isNull() && map.getEntry(1).key.getString() == string
+          , "erased entries stay in place");
+}
+
+} // namespace
+
+} // namespace OYC
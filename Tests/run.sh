@@ -0,0 +1,31 @@
+#!/bin/sh
+# Builds Source/*.cxx into a static library, then builds every Tests/*.cxx program against it
+# and runs it from the repository root. Exits with a non-zero status if any test fails.
+
+set -e
+cd "$(dirname "$0")/.."
+buildDirectory=${BUILD_DIRECTORY:-_test_build}
+compile="${CXX:-c++} -std=c++17 ${CXXFLAGS:--O1 -g} -ISource"
+mkdir -p "$buildDirectory"
+
+for source in Source/*.cxx; do
+    $compile -c "$source" -o "$buildDirectory/$(basename "$source" .cxx).o"
+done
+
+rm -f "$buildDirectory/libOYC.a"
+ar rcs "$buildDirectory/libOYC.a" "$buildDirectory"/*.o
+status=0
+
+for test in Tests/*.cxx; do
+    name=$(basename "$test" .cxx)
+    $compile "$test" "$buildDirectory/libOYC.a" -o "$buildDirectory/$name"
+
+    if "$buildDirectory/$name"; then
+        echo "passed: $name"
+    else
+        echo "FAILED: $name"
+        status=1
+    fi
+done
+
+exit $status